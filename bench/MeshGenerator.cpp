@@ -0,0 +1,331 @@
+#include "MeshGenerator.h"
+#include "gmshparsercpp/Enums.h"
+#include "gmshparsercpp/Exception.h"
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+namespace gmshparsercpp::bench {
+
+namespace {
+
+/// Buffered writer for ASCII and binary MSH data
+class Writer {
+public:
+    explicit Writer(const std::string & file_name) : file(std::fopen(file_name.c_str(), "wb"))
+    {
+        if (this->file == nullptr)
+            throw Exception("Unable to open file '{}' for writing.", file_name);
+        this->buffer.reserve(BUFFER_SIZE);
+    }
+
+    ~Writer()
+    {
+        flush();
+        std::fclose(this->file);
+    }
+
+    void
+    text(const std::string & str)
+    {
+        this->buffer.insert(this->buffer.end(), str.begin(), str.end());
+        flush_if_full();
+    }
+
+    template <typename T>
+    void
+    value(T val)
+    {
+        auto ptr = reinterpret_cast<const char *>(&val);
+        this->buffer.insert(this->buffer.end(), ptr, ptr + sizeof(T));
+        flush_if_full();
+    }
+
+private:
+    static constexpr std::size_t BUFFER_SIZE = 1 << 20;
+
+    void
+    flush_if_full()
+    {
+        if (this->buffer.size() >= BUFFER_SIZE)
+            flush();
+    }
+
+    void
+    flush()
+    {
+        std::fwrite(this->buffer.data(), 1, this->buffer.size(), this->file);
+        this->buffer.clear();
+    }
+
+    std::FILE * file;
+    std::vector<char> buffer;
+};
+
+using Cell = std::array<std::size_t, 8>;
+
+/// Format a coordinate the way gmsh does (shortest representation with full precision)
+std::string
+num(double val)
+{
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.16g", val);
+    return buf;
+}
+
+/// Corner nodes of a hexahedral cell (1-based node tags)
+Cell
+hex_cell(std::size_t n, std::size_t i, std::size_t j, std::size_t k)
+{
+    auto np = n + 1;
+    auto id = [&](std::size_t a, std::size_t b, std::size_t c) {
+        return a + b * np + c * np * np + 1;
+    };
+    return { id(i, j, k),         id(i + 1, j, k),     id(i + 1, j + 1, k),
+             id(i, j + 1, k),     id(i, j, k + 1),     id(i + 1, j, k + 1),
+             id(i + 1, j + 1, k + 1), id(i, j + 1, k + 1) };
+}
+
+ElementType
+element_type(CellType type)
+{
+    switch (type) {
+    case CellType::HEX:
+        return HEX8;
+    case CellType::PRISM:
+        return PRISM6;
+    case CellType::TET:
+        return TET4;
+    }
+    return NONE;
+}
+
+std::size_t
+elements_per_cell(CellType type)
+{
+    switch (type) {
+    case CellType::HEX:
+        return 1;
+    case CellType::PRISM:
+        return 2;
+    case CellType::TET:
+        return 6;
+    }
+    return 0;
+}
+
+/// Call `fn` with the connectivity of every element in the mesh
+template <typename FN>
+void
+for_each_element(const MeshSpec & spec, FN fn)
+{
+    // splitting of a hex cell with corners numbered 0..7
+    static const std::size_t prisms[2][6] = { { 0, 1, 2, 4, 5, 6 }, { 0, 2, 3, 4, 6, 7 } };
+    static const std::size_t tets[6][4] = { { 0, 1, 2, 6 }, { 0, 2, 3, 6 }, { 0, 3, 7, 6 },
+                                            { 0, 7, 4, 6 }, { 0, 4, 5, 6 }, { 0, 5, 1, 6 } };
+    std::size_t conn[8];
+    for (std::size_t k = 0; k < spec.n; k++)
+        for (std::size_t j = 0; j < spec.n; j++)
+            for (std::size_t i = 0; i < spec.n; i++) {
+                auto hex = hex_cell(spec.n, i, j, k);
+                switch (spec.cell_type) {
+                case CellType::HEX:
+                    fn(hex.data(), 8);
+                    break;
+                case CellType::PRISM:
+                    for (auto & p : prisms) {
+                        for (std::size_t c = 0; c < 6; c++)
+                            conn[c] = hex[p[c]];
+                        fn(conn, 6);
+                    }
+                    break;
+                case CellType::TET:
+                    for (auto & t : tets) {
+                        for (std::size_t c = 0; c < 4; c++)
+                            conn[c] = hex[t[c]];
+                        fn(conn, 4);
+                    }
+                    break;
+                }
+            }
+}
+
+void
+write_mesh_format(Writer & w, const MeshSpec & spec)
+{
+    w.text("$MeshFormat\n");
+    w.text(spec.version == 2 ? "2.2" : "4.1");
+    w.text(spec.binary ? " 1 8\n" : " 0 8\n");
+    if (spec.binary) {
+        w.value<int>(1);
+        w.text("\n");
+    }
+    w.text("$EndMeshFormat\n");
+}
+
+void
+write_nodes(Writer & w, const MeshSpec & spec, std::size_t num_nodes)
+{
+    auto np = spec.n + 1;
+    auto h = 1. / spec.n;
+    auto coord = [&](std::size_t idx, double xyz[3]) {
+        xyz[0] = (idx % np) * h;
+        xyz[1] = ((idx / np) % np) * h;
+        xyz[2] = (idx / (np * np)) * h;
+    };
+
+    w.text("$Nodes\n");
+    double xyz[3];
+    if (spec.version == 2) {
+        w.text(std::to_string(num_nodes) + "\n");
+        for (std::size_t i = 0; i < num_nodes; i++) {
+            coord(i, xyz);
+            if (spec.binary) {
+                w.value<int>(i + 1);
+                for (auto c : xyz)
+                    w.value<double>(c);
+            }
+            else
+                w.text(std::to_string(i + 1) + " " + num(xyz[0]) + " " + num(xyz[1]) + " " +
+                       num(xyz[2]) + "\n");
+        }
+    }
+    else {
+        if (spec.binary) {
+            for (std::size_t v : { std::size_t(1), num_nodes, std::size_t(1), num_nodes })
+                w.value<std::size_t>(v);
+            w.value<int>(3);
+            w.value<int>(1);
+            w.value<int>(0);
+            w.value<std::size_t>(num_nodes);
+            for (std::size_t i = 0; i < num_nodes; i++)
+                w.value<std::size_t>(i + 1);
+            for (std::size_t i = 0; i < num_nodes; i++) {
+                coord(i, xyz);
+                for (auto c : xyz)
+                    w.value<double>(c);
+            }
+        }
+        else {
+            w.text("1 " + std::to_string(num_nodes) + " 1 " + std::to_string(num_nodes) + "\n");
+            w.text("3 1 0 " + std::to_string(num_nodes) + "\n");
+            for (std::size_t i = 0; i < num_nodes; i++)
+                w.text(std::to_string(i + 1) + "\n");
+            for (std::size_t i = 0; i < num_nodes; i++) {
+                coord(i, xyz);
+                w.text(num(xyz[0]) + " " + num(xyz[1]) + " " + num(xyz[2]) + "\n");
+            }
+        }
+    }
+    if (spec.binary)
+        w.text("\n");
+    w.text("$EndNodes\n");
+}
+
+void
+write_elements(Writer & w, const MeshSpec & spec, std::size_t num_elements)
+{
+    int type = element_type(spec.cell_type);
+    std::size_t tag = 1;
+
+    w.text("$Elements\n");
+    if (spec.version == 2) {
+        w.text(std::to_string(num_elements) + "\n");
+        if (spec.binary) {
+            // one header for all elements: type, number of elements, number of tags
+            w.value<int>(type);
+            w.value<int>(num_elements);
+            w.value<int>(2);
+        }
+        for_each_element(spec, [&](const std::size_t * conn, std::size_t n_nodes) {
+            if (spec.binary) {
+                w.value<int>(tag);
+                w.value<int>(1);
+                w.value<int>(1);
+                for (std::size_t c = 0; c < n_nodes; c++)
+                    w.value<int>(conn[c]);
+            }
+            else {
+                std::string line = std::to_string(tag) + " " + std::to_string(type) + " 2 1 1";
+                for (std::size_t c = 0; c < n_nodes; c++)
+                    line += " " + std::to_string(conn[c]);
+                w.text(line + "\n");
+            }
+            tag++;
+        });
+    }
+    else {
+        if (spec.binary) {
+            for (std::size_t v : { std::size_t(1), num_elements, std::size_t(1), num_elements })
+                w.value<std::size_t>(v);
+            w.value<int>(3);
+            w.value<int>(1);
+            w.value<int>(type);
+            w.value<std::size_t>(num_elements);
+        }
+        else {
+            w.text("1 " + std::to_string(num_elements) + " 1 " + std::to_string(num_elements) +
+                   "\n");
+            w.text("3 1 " + std::to_string(type) + " " + std::to_string(num_elements) + "\n");
+        }
+        for_each_element(spec, [&](const std::size_t * conn, std::size_t n_nodes) {
+            if (spec.binary) {
+                w.value<std::size_t>(tag);
+                for (std::size_t c = 0; c < n_nodes; c++)
+                    w.value<std::size_t>(conn[c]);
+            }
+            else {
+                std::string line = std::to_string(tag);
+                for (std::size_t c = 0; c < n_nodes; c++)
+                    line += " " + std::to_string(conn[c]);
+                w.text(line + "\n");
+            }
+            tag++;
+        });
+    }
+    if (spec.binary)
+        w.text("\n");
+    w.text("$EndElements\n");
+}
+
+} // namespace
+
+MeshInfo
+write_mesh(const std::string & file_name, const MeshSpec & spec)
+{
+    if (spec.version != 2 && spec.version != 4)
+        throw Exception("Unsupported version {}", spec.version);
+    if (spec.n == 0)
+        throw Exception("Mesh must have at least one cell per side.");
+
+    MeshInfo info;
+    info.num_nodes = (spec.n + 1) * (spec.n + 1) * (spec.n + 1);
+    info.num_elements = spec.n * spec.n * spec.n * elements_per_cell(spec.cell_type);
+    {
+        Writer w(file_name);
+        write_mesh_format(w, spec);
+        if (spec.nodes)
+            write_nodes(w, spec, info.num_nodes);
+        if (spec.elements)
+            write_elements(w, spec, info.num_elements);
+    }
+    info.file_size = std::filesystem::file_size(file_name);
+    return info;
+}
+
+const char *
+cell_type_name(CellType type)
+{
+    switch (type) {
+    case CellType::HEX:
+        return "hex";
+    case CellType::PRISM:
+        return "prism";
+    case CellType::TET:
+        return "tet";
+    }
+    return "unknown";
+}
+
+} // namespace gmshparsercpp::bench
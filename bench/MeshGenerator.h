@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace gmshparsercpp::bench {
+
+/// Type of cells filling the structured box
+enum class CellType { HEX, PRISM, TET };
+
+/// Description of a synthetic mesh
+struct MeshSpec {
+    /// Type of cells
+    CellType cell_type = CellType::HEX;
+    /// Number of hexahedral cells along each side of the unit box
+    std::size_t n = 10;
+    /// File format major version (2 or 4)
+    int version = 4;
+    /// Write binary file
+    bool binary = false;
+    /// Write `$Nodes` section
+    bool nodes = true;
+    /// Write `$Elements` section
+    bool elements = true;
+};
+
+/// Summary of a written mesh
+struct MeshInfo {
+    /// Number of nodes in the mesh
+    std::size_t num_nodes = 0;
+    /// Number of elements in the mesh
+    std::size_t num_elements = 0;
+    /// Size of the file in bytes
+    std::uintmax_t file_size = 0;
+};
+
+/// Write a structured mesh of the unit box into a MSH file
+///
+/// The box is split into `n^3` hexahedral cells which are written as they are, split into 2
+/// prisms or split into 6 tetrahedra.
+///
+/// @param file_name File name
+/// @param spec Mesh description
+/// @return Summary of the written mesh
+MeshInfo write_mesh(const std::string & file_name, const MeshSpec & spec);
+
+/// Get human readable name of a cell type
+const char * cell_type_name(CellType type);
+
+} // namespace gmshparsercpp::bench
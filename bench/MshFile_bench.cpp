@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+#include "MeshGenerator.h"
+#include "gmshparsercpp/MshFile.h"
+#include <cstdlib>
+#include <filesystem>
+#include <sstream>
+
+using namespace gmshparsercpp;
+using namespace gmshparsercpp::bench;
+
+namespace {
+
+/// Sections a benchmark covers
+enum class Sections { ALL, NODES, ELEMENTS };
+
+/// Get the mesh sizes (number of cells per side) to benchmark
+///
+/// Defaults to small meshes; set GMSHPARSERCPP_BENCH_CELLS to a comma separated list, e.g. "100,215"
+/// for 1M and 10M hex elements (6x that for tets).
+std::vector<std::size_t>
+mesh_sizes()
+{
+    std::vector<std::size_t> sizes;
+    if (auto env = std::getenv("GMSHPARSERCPP_BENCH_CELLS")) {
+        std::stringstream ss(env);
+        std::string item;
+        while (std::getline(ss, item, ','))
+            sizes.push_back(std::stoul(item));
+    }
+    else
+        sizes = { 16, 48 };
+    return sizes;
+}
+
+void
+bm_parse(benchmark::State & state, MeshSpec spec)
+{
+    auto file_name = (std::filesystem::temp_directory_path() / "gmshparsercpp-bench.msh").string();
+    auto info = write_mesh(file_name, spec);
+
+#ifdef GMSHPARSERCPP_COUNT_ALLOCATIONS
+    std::size_t num_allocations = 0;
+#endif
+    for (auto _ : state) {
+        MshFile f(file_name);
+#ifdef GMSHPARSERCPP_COUNT_ALLOCATIONS
+        f.set_collect_stats(true);
+#endif
+        f.parse();
+#ifdef GMSHPARSERCPP_COUNT_ALLOCATIONS
+        num_allocations = f.get_stats().num_allocations;
+#endif
+        benchmark::DoNotOptimize(f.get_element_blocks().data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * info.file_size);
+    if (spec.nodes)
+        state.counters["nodes/s"] =
+            benchmark::Counter(info.num_nodes, benchmark::Counter::kIsIterationInvariantRate);
+    if (spec.elements)
+        state.counters["elements/s"] =
+            benchmark::Counter(info.num_elements, benchmark::Counter::kIsIterationInvariantRate);
+#ifdef GMSHPARSERCPP_COUNT_ALLOCATIONS
+    state.counters["allocs"] = num_allocations;
+#endif
+    std::filesystem::remove(file_name);
+}
+
+bool
+register_benchmarks()
+{
+    for (auto n : mesh_sizes())
+        for (auto type : { CellType::HEX, CellType::PRISM, CellType::TET })
+            for (auto version : { 2, 4 })
+                for (auto binary : { false, true })
+                    for (auto sections : { Sections::ALL, Sections::NODES, Sections::ELEMENTS }) {
+                        MeshSpec spec;
+                        spec.cell_type = type;
+                        spec.n = n;
+                        spec.version = version;
+                        spec.binary = binary;
+                        spec.nodes = sections != Sections::ELEMENTS;
+                        spec.elements = sections != Sections::NODES;
+
+                        std::string name = "parse";
+                        if (sections == Sections::NODES)
+                            name += "/nodes";
+                        else if (sections == Sections::ELEMENTS)
+                            name += "/elements";
+                        name += std::string("/") + cell_type_name(type) + "/v" +
+                                std::to_string(version) + (binary ? "/bin" : "/asc") + "/n:" +
+                                std::to_string(n);
+                        benchmark::RegisterBenchmark(name.c_str(), bm_parse, spec)
+                            ->Unit(benchmark::kMillisecond)
+                            ->UseRealTime();
+                    }
+    return true;
+}
+
+/// Mesh sizes are only known at run-time, so the benchmarks are registered dynamically
+const bool registered = register_benchmarks();
+
+} // namespace
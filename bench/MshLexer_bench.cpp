@@ -0,0 +1,206 @@
+#include <benchmark/benchmark.h>
+#include "gmshparsercpp/MshLexer.h"
+#include <random>
+#include <sstream>
+
+using namespace gmshparsercpp;
+
+namespace {
+
+constexpr std::size_t NUM_VALUES = 1 << 16;
+
+/// Buffer with integers separated by single spaces and new lines (like connectivity)
+std::string
+integer_buffer()
+{
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<int> dist(1, 10000000);
+    std::string buf;
+    for (std::size_t i = 0; i < NUM_VALUES; i++) {
+        buf += std::to_string(dist(gen));
+        buf += (i % 8 == 7) ? '\n' : ' ';
+    }
+    return buf;
+}
+
+/// Buffer with full precision doubles (like coordinates written by gmsh)
+std::string
+double_buffer()
+{
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<double> dist(-1000., 1000.);
+    std::string buf;
+    char str[32];
+    for (std::size_t i = 0; i < NUM_VALUES; i++) {
+        std::snprintf(str, sizeof(str), "%.16g", dist(gen));
+        buf += str;
+        buf += (i % 3 == 2) ? '\n' : ' ';
+    }
+    return buf;
+}
+
+/// Buffer with short numbers separated by long runs of white space
+std::string
+whitespace_buffer()
+{
+    std::string buf;
+    for (std::size_t i = 0; i < NUM_VALUES; i++) {
+        buf += std::to_string(i % 10);
+        buf += "  \t    \t      \r\n";
+    }
+    return buf;
+}
+
+/// Binary buffer with doubles
+std::string
+binary_buffer()
+{
+    std::string buf;
+    for (std::size_t i = 0; i < NUM_VALUES; i++) {
+        double val = i * 0.5;
+        buf.append(reinterpret_cast<const char *>(&val), sizeof(val));
+    }
+    return buf;
+}
+
+void
+bm_read_token(benchmark::State & state, std::string (*make_buffer)())
+{
+    auto buf = make_buffer();
+    std::size_t n_tokens = 0;
+    for (auto _ : state) {
+        std::istringstream in(buf);
+        MshLexer lexer(&in);
+        n_tokens = 0;
+        while (lexer.read().type != MshLexer::Token::EndOfFile)
+            n_tokens++;
+    }
+    state.SetBytesProcessed(state.iterations() * buf.size());
+    state.counters["tokens/s"] =
+        benchmark::Counter(n_tokens, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+template <typename T>
+void
+get(benchmark::State & state, const std::string & buf)
+{
+    for (auto _ : state) {
+        std::istringstream in(buf);
+        MshLexer lexer(&in);
+        for (std::size_t i = 0; i < NUM_VALUES; i++)
+            benchmark::DoNotOptimize(lexer.get<T>());
+    }
+    state.SetBytesProcessed(state.iterations() * buf.size());
+    state.SetItemsProcessed(state.iterations() * NUM_VALUES);
+}
+
+template <typename T>
+void
+get_bulk(benchmark::State & state, const std::string & buf)
+{
+    std::vector<T> values(NUM_VALUES);
+    for (auto _ : state) {
+        std::istringstream in(buf);
+        MshLexer lexer(&in);
+        lexer.get(values.data(), values.size());
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetBytesProcessed(state.iterations() * buf.size());
+    state.SetItemsProcessed(state.iterations() * NUM_VALUES);
+}
+
+template <typename T>
+void
+token_as(benchmark::State & state, const std::string & buf)
+{
+    std::istringstream in(buf);
+    MshLexer lexer(&in);
+    std::vector<MshLexer::Token> tokens;
+    for (std::size_t i = 0; i < NUM_VALUES; i++)
+        tokens.push_back(lexer.read());
+
+    for (auto _ : state)
+        for (auto & tok : tokens)
+            benchmark::DoNotOptimize(tok.as<T>());
+    state.SetItemsProcessed(state.iterations() * tokens.size());
+}
+
+void
+bm_get_int(benchmark::State & state)
+{
+    get<int>(state, integer_buffer());
+}
+
+void
+bm_get_size_t(benchmark::State & state)
+{
+    get<size_t>(state, integer_buffer());
+}
+
+void
+bm_get_double(benchmark::State & state)
+{
+    get<double>(state, double_buffer());
+}
+
+void
+bm_get_bulk_int(benchmark::State & state)
+{
+    get_bulk<int>(state, integer_buffer());
+}
+
+void
+bm_get_bulk_double(benchmark::State & state)
+{
+    get_bulk<double>(state, double_buffer());
+}
+
+void
+bm_token_as_int(benchmark::State & state)
+{
+    token_as<int>(state, integer_buffer());
+}
+
+void
+bm_token_as_size_t(benchmark::State & state)
+{
+    token_as<size_t>(state, integer_buffer());
+}
+
+void
+bm_token_as_double(benchmark::State & state)
+{
+    token_as<double>(state, double_buffer());
+}
+
+void
+bm_read_blob(benchmark::State & state)
+{
+    auto buf = binary_buffer();
+    for (auto _ : state) {
+        std::istringstream in(buf);
+        MshLexer lexer(&in);
+        for (std::size_t i = 0; i < NUM_VALUES; i++)
+            benchmark::DoNotOptimize(lexer.read_blob<double>());
+    }
+    state.SetBytesProcessed(state.iterations() * buf.size());
+    state.SetItemsProcessed(state.iterations() * NUM_VALUES);
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(bm_read_token, integers, integer_buffer);
+BENCHMARK_CAPTURE(bm_read_token, doubles, double_buffer);
+BENCHMARK_CAPTURE(bm_read_token, whitespace, whitespace_buffer);
+
+BENCHMARK(bm_get_int);
+BENCHMARK(bm_get_size_t);
+BENCHMARK(bm_get_double);
+BENCHMARK(bm_get_bulk_int);
+BENCHMARK(bm_get_bulk_double);
+
+BENCHMARK(bm_token_as_int);
+BENCHMARK(bm_token_as_size_t);
+BENCHMARK(bm_token_as_double);
+
+BENCHMARK(bm_read_blob);
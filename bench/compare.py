@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+"""
+Compare two Google Benchmark JSON outputs and report throughput regressions.
+
+Usage:
+    gmshparsercpp-bench --benchmark_filter=bm_ --benchmark_out=current.json \\
+        --benchmark_out_format=json
+    compare.py baseline.json current.json [--threshold 0.05]
+
+Benchmarks are matched by name; benchmarks run with repetitions are compared by their mean.
+Throughput is taken from `bytes_per_second`, then `items_per_second`; benchmarks reporting neither
+are compared by `real_time`. The script exits with a non-zero status if any benchmark got slower
+than `threshold` (relative).
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(file_name):
+    with open(file_name) as f:
+        data = json.load(f)
+    results = {}
+    means = {}
+    for bm in data["benchmarks"]:
+        name = bm.get("run_name", bm["name"])
+        if bm.get("run_type") != "aggregate":
+            results[name] = bm
+        elif bm.get("aggregate_name") == "mean":
+            means[name] = bm
+    # with repetitions, compare the mean over the repetitions; other aggregates (median,
+    # stddev, ...) are ignored
+    results.update(means)
+    return results
+
+
+def speed(bm):
+    """Return (value, higher_is_better)"""
+    for key in ("bytes_per_second", "items_per_second"):
+        if key in bm:
+            return bm[key], True
+    return bm["real_time"], False
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("baseline", help="Baseline JSON file")
+    parser.add_argument("current", help="Current JSON file")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="Relative slowdown considered a regression (default: 0.05)")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+
+    regressions = 0
+    print("{:<50} {:>14} {:>14} {:>9}".format("benchmark", "baseline", "current", "change"))
+    for name, cur in current.items():
+        if name not in baseline:
+            print("{:<50} {:>14} {:>14} {:>9}".format(name, "-", "-", "new"))
+            continue
+        base_val, higher_is_better = speed(baseline[name])
+        cur_val, _ = speed(cur)
+        if higher_is_better:
+            change = cur_val / base_val - 1.
+        else:
+            change = base_val / cur_val - 1.
+        flag = ""
+        if change < -args.threshold:
+            flag = "  << regression"
+            regressions += 1
+        print("{:<50} {:>14.4g} {:>14.4g} {:>+8.1%}{}".format(name, base_val, cur_val, change,
+                                                             flag))
+
+    if regressions > 0:
+        print("\n{} benchmark(s) regressed by more than {:.1%}".format(regressions,
+                                                                       args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,186 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include "gmshparsercpp/ElementTraits.h"
+#include "gmshparsercpp/Exception.h"
+#include "gmshparsercpp/MshFile.h"
+
+namespace gmshparsercpp {
+
+/// Node tags of one element, with the number of nodes known at compile time
+///
+/// @tparam N Number of nodes
+template <int N>
+class ElementNodes {
+public:
+    using value_type = int;
+    using const_iterator = const int *;
+
+    explicit ElementNodes(const int * tags) : tags(tags) {}
+
+    /// Get the number of nodes
+    static constexpr int
+    size()
+    {
+        return N;
+    }
+
+    /// Get the tag of a node
+    ///
+    /// @param k Local node index
+    const int &
+    operator[](int k) const
+    {
+        return this->tags[k];
+    }
+
+    const int *
+    begin() const
+    {
+        return this->tags;
+    }
+
+    const int *
+    end() const
+    {
+        return this->tags + N;
+    }
+
+    /// Copy the node tags into an array
+    std::array<int, N>
+    to_array() const
+    {
+        std::array<int, N> arr;
+        for (int k = 0; k < N; k++)
+            arr[k] = this->tags[k];
+        return arr;
+    }
+
+private:
+    const int * tags;
+};
+
+/// View of an element block with the element type (and so the connectivity stride) fixed at
+/// compile time
+///
+/// @tparam TYPE Element type of the block
+template <ElementType TYPE>
+class ElementBlockView {
+public:
+    using Traits = ElementTraits<TYPE>;
+
+    /// Number of nodes per element
+    static constexpr int NUM_NODES = Traits::num_nodes;
+
+    /// Construct view
+    ///
+    /// @param block Element block, must hold elements of type `TYPE`
+    explicit ElementBlockView(const MshFile::ElementBlock & block) : blk(&block)
+    {
+        if (block.element_type != TYPE)
+            throw Exception("Element block holds '{}' elements, not '{}'.",
+                            block.element_type,
+                            TYPE);
+    }
+
+    /// Get the underlying element block
+    const MshFile::ElementBlock &
+    get_block() const
+    {
+        return *this->blk;
+    }
+
+    /// Get the number of elements
+    std::size_t
+    size() const
+    {
+        return this->blk->element_tags.size();
+    }
+
+    /// Get element tag
+    ///
+    /// @param i Element index
+    int
+    tag(std::size_t i) const
+    {
+        return this->blk->element_tags[i];
+    }
+
+    /// Get the node tags of an element
+    ///
+    /// @param i Element index
+    ElementNodes<NUM_NODES>
+    operator[](std::size_t i) const
+    {
+        return ElementNodes<NUM_NODES>(this->blk->connectivity.data() + i * NUM_NODES);
+    }
+
+    /// Get the flat connectivity (`NUM_NODES` consecutive entries per element)
+    const int *
+    data() const
+    {
+        return this->blk->connectivity.data();
+    }
+
+private:
+    const MshFile::ElementBlock * blk;
+};
+
+/// Call `func` with a view of `block` typed by the block's element type
+///
+/// `func` is typically a generic lambda, e.g. `[](auto view) { ... }`; inside, the number of
+/// nodes per element is the compile-time constant `decltype(view)::NUM_NODES`.
+///
+/// @param block Element block
+/// @param func Function to call, must return the same type for all element types
+/// @return What `func` returned
+template <typename F>
+decltype(auto)
+visit_element_block(const MshFile::ElementBlock & block, F && func)
+{
+    switch (block.element_type) {
+    // clang-format off
+    case POINT: return func(ElementBlockView<POINT>(block));
+    case LINE2: return func(ElementBlockView<LINE2>(block));
+    case LINE3: return func(ElementBlockView<LINE3>(block));
+    case LINE4: return func(ElementBlockView<LINE4>(block));
+    case LINE5: return func(ElementBlockView<LINE5>(block));
+    case LINE6: return func(ElementBlockView<LINE6>(block));
+    case TRI3: return func(ElementBlockView<TRI3>(block));
+    case TRI6: return func(ElementBlockView<TRI6>(block));
+    case ITRI9: return func(ElementBlockView<ITRI9>(block));
+    case TRI10: return func(ElementBlockView<TRI10>(block));
+    case ITRI12: return func(ElementBlockView<ITRI12>(block));
+    case TRI15: return func(ElementBlockView<TRI15>(block));
+    case ITRI15: return func(ElementBlockView<ITRI15>(block));
+    case TRI21: return func(ElementBlockView<TRI21>(block));
+    case QUAD4: return func(ElementBlockView<QUAD4>(block));
+    case QUAD8: return func(ElementBlockView<QUAD8>(block));
+    case QUAD9: return func(ElementBlockView<QUAD9>(block));
+    case TET4: return func(ElementBlockView<TET4>(block));
+    case TET10: return func(ElementBlockView<TET10>(block));
+    case TET20: return func(ElementBlockView<TET20>(block));
+    case TET35: return func(ElementBlockView<TET35>(block));
+    case TET56: return func(ElementBlockView<TET56>(block));
+    case HEX8: return func(ElementBlockView<HEX8>(block));
+    case HEX20: return func(ElementBlockView<HEX20>(block));
+    case HEX27: return func(ElementBlockView<HEX27>(block));
+    case HEX64: return func(ElementBlockView<HEX64>(block));
+    case HEX125: return func(ElementBlockView<HEX125>(block));
+    case PRISM6: return func(ElementBlockView<PRISM6>(block));
+    case PRISM15: return func(ElementBlockView<PRISM15>(block));
+    case PRISM18: return func(ElementBlockView<PRISM18>(block));
+    case PYRAMID5: return func(ElementBlockView<PYRAMID5>(block));
+    case PYRAMID13: return func(ElementBlockView<PYRAMID13>(block));
+    case PYRAMID14: return func(ElementBlockView<PYRAMID14>(block));
+    // clang-format on
+    default:
+        throw Exception("Unknown element type '{}'", block.element_type);
+    }
+}
+
+} // namespace gmshparsercpp
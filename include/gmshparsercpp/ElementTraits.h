@@ -0,0 +1,206 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include "gmshparsercpp/Enums.h"
+
+namespace gmshparsercpp {
+
+/// Shape of an element, regardless of its order
+enum class ElementFamily {
+    NONE,
+    POINT,
+    LINE,
+    TRIANGLE,
+    QUADRILATERAL,
+    TETRAHEDRON,
+    HEXAHEDRON,
+    PRISM,
+    PYRAMID
+};
+
+/// Properties of an element type
+struct ElementInfo {
+    /// Element type
+    ElementType type = NONE;
+    /// Number of nodes
+    int num_nodes = 0;
+    /// Spatial dimension
+    int dimension = -1;
+    /// Polynomial order
+    int order = 0;
+    /// Element shape
+    ElementFamily family = ElementFamily::NONE;
+    /// Number of corner (vertex) nodes, which come first in the connectivity
+    int num_corner_nodes = 0;
+
+    /// Check if this describes a known element type
+    constexpr bool
+    is_valid() const
+    {
+        return this->num_nodes > 0;
+    }
+};
+
+/// Face of a reference element, given by local indices of its corner nodes
+///
+/// Corners are ordered so that the face normal points out of the element.
+struct ReferenceFace {
+    /// Number of corners (3 or 4)
+    int num_nodes = 0;
+    /// Local corner indices
+    std::array<int, 4> nodes {};
+};
+
+/// Edges and faces of the reference element of an element family
+///
+/// Sub-entities are given by local indices of corner nodes and follow the gmsh numbering.
+struct ReferenceTopology {
+    /// Number of edges
+    int num_edges = 0;
+    /// Local corner indices of the edges
+    std::array<std::array<int, 2>, 12> edges {};
+    /// Number of faces
+    int num_faces = 0;
+    /// Faces
+    std::array<ReferenceFace, 6> faces {};
+};
+
+namespace detail {
+
+/// Largest value of `ElementType`
+constexpr int MAX_ELEMENT_TYPE = HEX125;
+
+constexpr std::array<ElementInfo, MAX_ELEMENT_TYPE + 1>
+make_element_info_table()
+{
+    using F = ElementFamily;
+    std::array<ElementInfo, MAX_ELEMENT_TYPE + 1> tbl {};
+    // clang-format off
+    for (auto info : {
+        ElementInfo { POINT,     1,   0, 0, F::POINT,         1 },
+        ElementInfo { LINE2,     2,   1, 1, F::LINE,          2 },
+        ElementInfo { LINE3,     3,   1, 2, F::LINE,          2 },
+        ElementInfo { LINE4,     4,   1, 3, F::LINE,          2 },
+        ElementInfo { LINE5,     5,   1, 4, F::LINE,          2 },
+        ElementInfo { LINE6,     6,   1, 5, F::LINE,          2 },
+        ElementInfo { TRI3,      3,   2, 1, F::TRIANGLE,      3 },
+        ElementInfo { TRI6,      6,   2, 2, F::TRIANGLE,      3 },
+        ElementInfo { ITRI9,     9,   2, 3, F::TRIANGLE,      3 },
+        ElementInfo { TRI10,     10,  2, 3, F::TRIANGLE,      3 },
+        ElementInfo { ITRI12,    12,  2, 4, F::TRIANGLE,      3 },
+        ElementInfo { TRI15,     15,  2, 4, F::TRIANGLE,      3 },
+        ElementInfo { ITRI15,    15,  2, 5, F::TRIANGLE,      3 },
+        ElementInfo { TRI21,     21,  2, 5, F::TRIANGLE,      3 },
+        ElementInfo { QUAD4,     4,   2, 1, F::QUADRILATERAL, 4 },
+        ElementInfo { QUAD8,     8,   2, 2, F::QUADRILATERAL, 4 },
+        ElementInfo { QUAD9,     9,   2, 2, F::QUADRILATERAL, 4 },
+        ElementInfo { TET4,      4,   3, 1, F::TETRAHEDRON,   4 },
+        ElementInfo { TET10,     10,  3, 2, F::TETRAHEDRON,   4 },
+        ElementInfo { TET20,     20,  3, 3, F::TETRAHEDRON,   4 },
+        ElementInfo { TET35,     35,  3, 4, F::TETRAHEDRON,   4 },
+        ElementInfo { TET56,     56,  3, 5, F::TETRAHEDRON,   4 },
+        ElementInfo { HEX8,      8,   3, 1, F::HEXAHEDRON,    8 },
+        ElementInfo { HEX20,     20,  3, 2, F::HEXAHEDRON,    8 },
+        ElementInfo { HEX27,     27,  3, 2, F::HEXAHEDRON,    8 },
+        ElementInfo { HEX64,     64,  3, 3, F::HEXAHEDRON,    8 },
+        ElementInfo { HEX125,    125, 3, 4, F::HEXAHEDRON,    8 },
+        ElementInfo { PRISM6,    6,   3, 1, F::PRISM,         6 },
+        ElementInfo { PRISM15,   15,  3, 2, F::PRISM,         6 },
+        ElementInfo { PRISM18,   18,  3, 2, F::PRISM,         6 },
+        ElementInfo { PYRAMID5,  5,   3, 1, F::PYRAMID,       5 },
+        ElementInfo { PYRAMID13, 13,  3, 2, F::PYRAMID,       5 },
+        ElementInfo { PYRAMID14, 14,  3, 2, F::PYRAMID,       5 } })
+        tbl[info.type] = info;
+    // clang-format on
+    return tbl;
+}
+
+/// Number of element families
+constexpr int NUM_ELEMENT_FAMILIES = static_cast<int>(ElementFamily::PYRAMID) + 1;
+
+constexpr std::array<ReferenceTopology, NUM_ELEMENT_FAMILIES>
+make_reference_topology_table()
+{
+    using F = ElementFamily;
+    std::array<ReferenceTopology, NUM_ELEMENT_FAMILIES> tbl {};
+    // clang-format off
+    tbl[int(F::LINE)] = { 1, { { { 0, 1 } } }, 0, {} };
+    tbl[int(F::TRIANGLE)] = {
+        3, { { { 0, 1 }, { 1, 2 }, { 2, 0 } } },
+        1, { { { 3, { 0, 1, 2 } } } } };
+    tbl[int(F::QUADRILATERAL)] = {
+        4, { { { 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 0 } } },
+        1, { { { 4, { 0, 1, 2, 3 } } } } };
+    tbl[int(F::TETRAHEDRON)] = {
+        6, { { { 0, 1 }, { 1, 2 }, { 2, 0 }, { 3, 0 }, { 3, 2 }, { 3, 1 } } },
+        4, { { { 3, { 0, 2, 1 } }, { 3, { 0, 1, 3 } }, { 3, { 0, 3, 2 } }, { 3, { 3, 1, 2 } } } } };
+    tbl[int(F::HEXAHEDRON)] = {
+        12, { { { 0, 1 }, { 0, 3 }, { 0, 4 }, { 1, 2 }, { 1, 5 }, { 2, 3 },
+                { 2, 6 }, { 3, 7 }, { 4, 5 }, { 4, 7 }, { 5, 6 }, { 6, 7 } } },
+        6, { { { 4, { 0, 3, 2, 1 } }, { 4, { 0, 1, 5, 4 } }, { 4, { 0, 4, 7, 3 } },
+               { 4, { 1, 2, 6, 5 } }, { 4, { 2, 3, 7, 6 } }, { 4, { 4, 5, 6, 7 } } } } };
+    tbl[int(F::PRISM)] = {
+        9, { { { 0, 1 }, { 0, 2 }, { 0, 3 }, { 1, 2 }, { 1, 4 }, { 2, 5 }, { 3, 4 }, { 3, 5 },
+               { 4, 5 } } },
+        5, { { { 3, { 0, 2, 1 } }, { 3, { 3, 4, 5 } }, { 4, { 0, 1, 4, 3 } },
+               { 4, { 0, 3, 5, 2 } }, { 4, { 1, 2, 5, 4 } } } } };
+    tbl[int(F::PYRAMID)] = {
+        8, { { { 0, 1 }, { 0, 3 }, { 0, 4 }, { 1, 2 }, { 1, 4 }, { 2, 3 }, { 2, 4 }, { 3, 4 } } },
+        5, { { { 3, { 0, 1, 4 } }, { 3, { 3, 0, 4 } }, { 3, { 1, 2, 4 } }, { 3, { 2, 3, 4 } },
+               { 4, { 0, 3, 2, 1 } } } } };
+    // clang-format on
+    return tbl;
+}
+
+} // namespace detail
+
+/// Table of element properties indexed by `ElementType` (unused slots are not valid)
+inline constexpr auto ELEMENT_INFO = detail::make_element_info_table();
+
+/// Get the properties of an element type
+///
+/// @param type Element type
+/// @return Element properties, not valid (see `ElementInfo::is_valid`) for unknown element types
+constexpr const ElementInfo &
+element_info(ElementType type)
+{
+    if (type >= 0 && type <= detail::MAX_ELEMENT_TYPE)
+        return ELEMENT_INFO[type];
+    else
+        return ELEMENT_INFO[0];
+}
+
+/// Table of reference element edges and faces indexed by `ElementFamily`
+inline constexpr auto REFERENCE_TOPOLOGY = detail::make_reference_topology_table();
+
+/// Get the edges and faces of the reference element of an element family
+///
+/// @param family Element family
+/// @return Reference topology (no edges and faces for `NONE` and `POINT`)
+constexpr const ReferenceTopology &
+reference_topology(ElementFamily family)
+{
+    return REFERENCE_TOPOLOGY[static_cast<int>(family)];
+}
+
+/// Compile-time properties of an element type
+///
+/// @tparam TYPE Element type
+template <ElementType TYPE>
+struct ElementTraits {
+    static_assert(element_info(TYPE).is_valid(), "Unknown element type");
+
+    static constexpr ElementType type = TYPE;
+    static constexpr int num_nodes = element_info(TYPE).num_nodes;
+    static constexpr int dimension = element_info(TYPE).dimension;
+    static constexpr int order = element_info(TYPE).order;
+    static constexpr ElementFamily family = element_info(TYPE).family;
+    static constexpr int num_corner_nodes = element_info(TYPE).num_corner_nodes;
+    static constexpr int num_edges = reference_topology(family).num_edges;
+    static constexpr int num_faces = reference_topology(family).num_faces;
+};
+
+} // namespace gmshparsercpp
@@ -40,4 +40,10 @@ private:
     std::string msg;
 };
 
+/// Exception thrown when parsing was cancelled
+class CancelledException : public Exception {
+public:
+    CancelledException() : Exception("Parsing was cancelled.") {}
+};
+
 } // namespace gmshparsercpp
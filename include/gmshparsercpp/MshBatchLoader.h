@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "gmshparsercpp/MshFile.h"
+
+namespace gmshparsercpp {
+
+/// Loader parsing many MSH files concurrently
+///
+/// Files are distributed over a pool of worker threads. Every worker owns one `MshFile` that is
+/// re-opened for each of its files, so the memory allocated for one mesh is reused by the next.
+class MshBatchLoader {
+public:
+    /// Callback receiving a parsed file
+    ///
+    /// Called on a worker thread with the index of the file in the input list and the parsed file.
+    /// The file is re-used once the callback returns, so the data must be processed or moved out
+    /// (e.g. with `MshFile::release`) here. Calls for different files can run concurrently.
+    using Callback = std::function<void(std::size_t index, MshFile & file)>;
+
+    /// Callback setting up a parser before its first file
+    using SetupCallback = std::function<void(MshFile & file)>;
+
+    /// Construct batch loader
+    ///
+    /// @param num_threads Number of worker threads, 0 means one per hardware thread
+    explicit MshBatchLoader(unsigned int num_threads = 0);
+
+    /// Set a callback configuring each worker's parser (read-ahead, statistics, ...)
+    ///
+    /// @param setup Callback called once per worker
+    void set_setup_callback(SetupCallback setup);
+
+    /// Parse files
+    ///
+    /// Returns once all files are processed. If a file fails to parse (or the callback throws), no
+    /// more files are started and the first error is re-thrown from here.
+    ///
+    /// @param file_names Files to parse
+    /// @param callback Callback receiving each parsed file
+    void load(const std::vector<std::string> & file_names, const Callback & callback);
+
+private:
+    /// Number of worker threads
+    unsigned int num_threads;
+    /// Callback configuring the parsers
+    SetupCallback setup;
+};
+
+} // namespace gmshparsercpp
@@ -3,9 +3,15 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <string>
 #include <fstream>
+#include <memory>
+#include <memory_resource>
 #include <vector>
+#include "gmshparsercpp/ElementTraits.h"
 #include "gmshparsercpp/Enums.h"
 #include "gmshparsercpp/Exception.h"
 #include "gmshparsercpp/MshLexer.h"
@@ -13,6 +19,8 @@
 namespace gmshparsercpp {
 
 class MshLexer;
+class ReadAheadStreamBuf;
+class ThreadPool;
 
 /// Class for parsing MSH files
 ///
@@ -35,38 +43,93 @@ public:
         }
     };
 
+    /// Allocator of the containers holding parsed data
+    ///
+    /// Structures with nested containers are allocator-aware, so that a container of them passes
+    /// its memory resource down to the nested containers.
+    using Allocator = std::pmr::polymorphic_allocator<char>;
+
     struct PointEntity {
+        using allocator_type = Allocator;
+
         /// Entity tag
         int tag;
         /// physical location
         double x, y, z;
         /// physical tags
-        std::vector<int> physical_tags;
+        std::pmr::vector<int> physical_tags;
 
         PointEntity() : tag(-1), x(0.), y(0.), z(0.) {}
-        PointEntity(int tag, double x, double y, double z, const std::vector<int> & phys_tags) :
+        explicit PointEntity(const allocator_type & alloc) :
+            tag(-1),
+            x(0.),
+            y(0.),
+            z(0.),
+            physical_tags(alloc)
+        {
+        }
+        PointEntity(int tag,
+                    double x,
+                    double y,
+                    double z,
+                    const std::vector<int> & phys_tags,
+                    const allocator_type & alloc = {}) :
             tag(tag),
             x(x),
             y(y),
             z(z),
-            physical_tags(phys_tags)
+            physical_tags(phys_tags.begin(), phys_tags.end(), alloc)
         {
         }
+        PointEntity(const PointEntity & other, const allocator_type & alloc) :
+            tag(other.tag),
+            x(other.x),
+            y(other.y),
+            z(other.z),
+            physical_tags(other.physical_tags, alloc)
+        {
+        }
+        PointEntity(PointEntity && other, const allocator_type & alloc) :
+            tag(other.tag),
+            x(other.x),
+            y(other.y),
+            z(other.z),
+            physical_tags(std::move(other.physical_tags), alloc)
+        {
+        }
+        PointEntity(const PointEntity &) = default;
+        PointEntity(PointEntity &&) = default;
+        PointEntity & operator=(const PointEntity &) = default;
+        PointEntity & operator=(PointEntity &&) = default;
     };
 
     struct MultiDEntity {
+        using allocator_type = Allocator;
+
         /// Entity tag
         int tag;
         double min_x, min_y, min_z;
         double max_x, max_y, max_z;
         /// Physical tags
-        std::vector<int> physical_tags;
+        std::pmr::vector<int> physical_tags;
         /// bounding tags
-        std::vector<int> bounding_tags;
+        std::pmr::vector<int> bounding_tags;
 
         MultiDEntity() : tag(-1), min_x(0.), min_y(0.), min_z(0.), max_x(0.), max_y(0.), max_z(0.)
         {
         }
+        explicit MultiDEntity(const allocator_type & alloc) :
+            tag(-1),
+            min_x(0.),
+            min_y(0.),
+            min_z(0.),
+            max_x(0.),
+            max_y(0.),
+            max_z(0.),
+            physical_tags(alloc),
+            bounding_tags(alloc)
+        {
+        }
         MultiDEntity(int tag,
                      double min_x,
                      double min_y,
@@ -75,7 +138,8 @@ public:
                      double max_y,
                      double max_z,
                      const std::vector<int> & phys_tags,
-                     const std::vector<int> & bnd_tags) :
+                     const std::vector<int> & bnd_tags,
+                     const allocator_type & alloc = {}) :
             tag(tag),
             min_x(min_x),
             min_y(min_y),
@@ -83,10 +147,38 @@ public:
             max_x(max_x),
             max_y(max_y),
             max_z(max_z),
-            physical_tags(phys_tags),
-            bounding_tags(bnd_tags)
+            physical_tags(phys_tags.begin(), phys_tags.end(), alloc),
+            bounding_tags(bnd_tags.begin(), bnd_tags.end(), alloc)
         {
         }
+        MultiDEntity(const MultiDEntity & other, const allocator_type & alloc) :
+            tag(other.tag),
+            min_x(other.min_x),
+            min_y(other.min_y),
+            min_z(other.min_z),
+            max_x(other.max_x),
+            max_y(other.max_y),
+            max_z(other.max_z),
+            physical_tags(other.physical_tags, alloc),
+            bounding_tags(other.bounding_tags, alloc)
+        {
+        }
+        MultiDEntity(MultiDEntity && other, const allocator_type & alloc) :
+            tag(other.tag),
+            min_x(other.min_x),
+            min_y(other.min_y),
+            min_z(other.min_z),
+            max_x(other.max_x),
+            max_y(other.max_y),
+            max_z(other.max_z),
+            physical_tags(std::move(other.physical_tags), alloc),
+            bounding_tags(std::move(other.bounding_tags), alloc)
+        {
+        }
+        MultiDEntity(const MultiDEntity &) = default;
+        MultiDEntity(MultiDEntity &&) = default;
+        MultiDEntity & operator=(const MultiDEntity &) = default;
+        MultiDEntity & operator=(MultiDEntity &&) = default;
     };
 
     struct Point {
@@ -96,7 +188,24 @@ public:
         Point(double x, double y, double z) : x(x), y(y), z(z) {}
     };
 
+    /// Point stored in single precision
+    struct FloatPoint {
+        float x, y, z;
+
+        FloatPoint() : x(0.f), y(0.f), z(0.f) {}
+        FloatPoint(float x, float y, float z) : x(x), y(y), z(z) {}
+    };
+
+    /// Floating point precision of stored coordinates
+    enum class Precision { DOUBLE, SINGLE };
+
+    /// Block of nodes sharing an entity
+    ///
+    /// Parametric coordinates are stored flat with the block dimension as stride: node `i` uses
+    /// entries `[i * n, (i + 1) * n)` of `par_coords`, where `n` is `get_num_par_coords()`.
     struct Node {
+        using allocator_type = Allocator;
+
         /// Physical entity dimension
         int dimension;
         /// Entity tag
@@ -104,44 +213,390 @@ public:
         /// Is parametric
         bool parametric;
         /// Node tags
-        std::vector<int> tags;
-        /// Coordinates
-        std::vector<Point> coordinates;
-        /// Parametric coordinates
-        std::vector<Point> par_coords;
+        std::pmr::vector<int> tags;
+        /// Coordinates (empty if stored in single precision)
+        std::pmr::vector<Point> coordinates;
+        /// Parametric coordinates (empty if stored in single precision or not read)
+        std::pmr::vector<double> par_coords;
+        /// Coordinates in single precision (filled instead of `coordinates` with
+        /// `Precision::SINGLE`)
+        std::pmr::vector<FloatPoint> float_coordinates;
+        /// Parametric coordinates in single precision
+        std::pmr::vector<float> float_par_coords;
 
         Node() : dimension(-1), entity_tag(-1), parametric(false) {}
-    };
+        explicit Node(const allocator_type & alloc) :
+            dimension(-1),
+            entity_tag(-1),
+            parametric(false),
+            tags(alloc),
+            coordinates(alloc),
+            par_coords(alloc),
+            float_coordinates(alloc),
+            float_par_coords(alloc)
+        {
+        }
+        Node(const Node & other, const allocator_type & alloc) :
+            dimension(other.dimension),
+            entity_tag(other.entity_tag),
+            parametric(other.parametric),
+            tags(other.tags, alloc),
+            coordinates(other.coordinates, alloc),
+            par_coords(other.par_coords, alloc),
+            float_coordinates(other.float_coordinates, alloc),
+            float_par_coords(other.float_par_coords, alloc)
+        {
+        }
+        Node(Node && other, const allocator_type & alloc) :
+            dimension(other.dimension),
+            entity_tag(other.entity_tag),
+            parametric(other.parametric),
+            tags(std::move(other.tags), alloc),
+            coordinates(std::move(other.coordinates), alloc),
+            par_coords(std::move(other.par_coords), alloc),
+            float_coordinates(std::move(other.float_coordinates), alloc),
+            float_par_coords(std::move(other.float_par_coords), alloc)
+        {
+        }
+        Node(const Node &) = default;
+        Node(Node &&) = default;
+        Node & operator=(const Node &) = default;
+        Node & operator=(Node &&) = default;
+
+        /// Get the number of parametric coordinates per node
+        ///
+        /// @return Block dimension for parametric blocks, 0 otherwise
+        std::size_t
+        get_num_par_coords() const
+        {
+            return this->parametric ? std::clamp(this->dimension, 0, 3) : 0;
+        }
 
-    struct Element {
-        /// Element tag
-        int tag;
-        /// Node tags
-        std::vector<int> node_tags;
+        /// Get parametric coordinates of a node
+        ///
+        /// @param i Index of the node within the block
+        /// @return Pointer to `get_num_par_coords()` values, `nullptr` if parametric coordinates
+        ///         are not stored in double precision (`Precision::SINGLE` or
+        ///         `set_read_par_coords(false)`)
+        const double *
+        get_par_coords(std::size_t i) const
+        {
+            if (this->par_coords.empty())
+                return nullptr;
+            return this->par_coords.data() + i * get_num_par_coords();
+        }
 
-        Element() : tag(-1) {}
+        /// Get parametric coordinates of a node stored in single precision
+        ///
+        /// @param i Index of the node within the block
+        /// @return Pointer to `get_num_par_coords()` values, `nullptr` if parametric coordinates
+        ///         are not stored in single precision (`Precision::DOUBLE` or
+        ///         `set_read_par_coords(false)`)
+        const float *
+        get_float_par_coords(std::size_t i) const
+        {
+            if (this->float_par_coords.empty())
+                return nullptr;
+            return this->float_par_coords.data() + i * get_num_par_coords();
+        }
     };
 
+    /// Elements of one type sharing an entity (v4) or a physical tag (v2)
+    ///
+    /// Connectivity is stored flat: element `i` uses entries `[i * n, (i + 1) * n)` of
+    /// `connectivity`, where `n` is the number of nodes per element.
     struct ElementBlock {
+        using allocator_type = Allocator;
+
         /// Block dimension
         int dimension;
         /// Block tag
         int tag;
         /// Element type
         ElementType element_type;
-        /// Elements
-        std::vector<Element> elements;
+        /// Element tags
+        std::pmr::vector<int> element_tags;
+        /// Node tags of all elements
+        std::pmr::vector<int> connectivity;
 
         ElementBlock() : dimension(-1), tag(-1), element_type(NONE) {}
+        explicit ElementBlock(const allocator_type & alloc) :
+            dimension(-1),
+            tag(-1),
+            element_type(NONE),
+            element_tags(alloc),
+            connectivity(alloc)
+        {
+        }
+        ElementBlock(const ElementBlock & other, const allocator_type & alloc) :
+            dimension(other.dimension),
+            tag(other.tag),
+            element_type(other.element_type),
+            element_tags(other.element_tags, alloc),
+            connectivity(other.connectivity, alloc)
+        {
+        }
+        ElementBlock(ElementBlock && other, const allocator_type & alloc) :
+            dimension(other.dimension),
+            tag(other.tag),
+            element_type(other.element_type),
+            element_tags(std::move(other.element_tags), alloc),
+            connectivity(std::move(other.connectivity), alloc)
+        {
+        }
+        ElementBlock(const ElementBlock &) = default;
+        ElementBlock(ElementBlock &&) = default;
+        ElementBlock & operator=(const ElementBlock &) = default;
+        ElementBlock & operator=(ElementBlock &&) = default;
+
+        /// Get the number of elements
+        std::size_t
+        size() const
+        {
+            return this->element_tags.size();
+        }
+
+        /// Get the number of nodes per element
+        int
+        get_num_nodes_per_element() const
+        {
+            return element_info(this->element_type).num_nodes;
+        }
+
+        /// Get the node tags of an element
+        ///
+        /// @param i Element index
+        /// @return Pointer to `get_num_nodes_per_element()` node tags
+        const int *
+        get_node_tags(std::size_t i) const
+        {
+            return this->connectivity.data() + i * get_num_nodes_per_element();
+        }
+    };
+
+    /// Parsed mesh data, moved out of the file by `release`
+    struct Mesh {
+        /// Physical names
+        std::pmr::vector<PhysicalName> physical_names;
+        /// Point entities
+        std::pmr::vector<PointEntity> point_entities;
+        /// Curve entities
+        std::pmr::vector<MultiDEntity> curve_entities;
+        /// Surface entities
+        std::pmr::vector<MultiDEntity> surface_entities;
+        /// Volume entities
+        std::pmr::vector<MultiDEntity> volume_entities;
+        /// Nodes
+        std::pmr::vector<Node> nodes;
+        /// Element blocks
+        std::pmr::vector<ElementBlock> element_blocks;
     };
 
+    /// Statistics about one section of the file
+    struct SectionStats {
+        /// Section name (e.g. `$Nodes`)
+        std::string name;
+        /// Flag indicating that the section was skipped without being decoded
+        bool skipped;
+        /// Wall time spent in the section [s]
+        double time;
+        /// Number of bytes consumed (after decompression)
+        std::size_t num_bytes;
+        /// Number of tokens read
+        std::size_t num_tokens;
+        /// Number of values decoded
+        std::size_t num_values;
+        /// Number of allocations made by the parser (only counted with
+        /// GMSHPARSERCPP_COUNT_ALLOCATIONS)
+        ///
+        /// Counted are: parsed data (everything allocated from the memory resource), physical
+        /// names and token strings that do not fit into the small string buffer (including copies
+        /// returned by `MshLexer::peek`), growth of the lexer input buffer, and the row and payload
+        /// buffers of the decoders. Not counted are the parser's fixed bookkeeping (the initial
+        /// lexer buffers, read-ahead and decompression buffers, statistics, thread pool tasks)
+        /// and allocations made by the progress callback.
+        std::size_t num_allocations;
+        /// Number of bytes requested by the allocations counted in `num_allocations`
+        std::size_t allocated_bytes;
+
+        SectionStats() :
+            skipped(false),
+            time(0.),
+            num_bytes(0),
+            num_tokens(0),
+            num_values(0),
+            num_allocations(0),
+            allocated_bytes(0)
+        {
+        }
+    };
+
+    /// Statistics about parsing the file
+    struct ParseStats {
+        /// Wall time spent in `parse` [s]
+        double time;
+        /// Number of bytes consumed (after decompression)
+        std::size_t num_bytes;
+        /// Number of allocations made by the parser, see `SectionStats::num_allocations`
+        std::size_t num_allocations;
+        /// Number of bytes requested by the allocations counted in `num_allocations`
+        std::size_t allocated_bytes;
+        /// Statistics of the individual sections in the order they appear in the file
+        std::vector<SectionStats> sections;
+
+        ParseStats() : time(0.), num_bytes(0), num_allocations(0), allocated_bytes(0) {}
+    };
+
+    /// Memory held by the parsed data
+    struct MemoryUsage {
+        /// Amount of memory in bytes
+        struct Amount {
+            /// Bytes holding data
+            std::size_t size;
+            /// Bytes allocated (size plus unused capacity)
+            std::size_t capacity;
+
+            Amount() : size(0), capacity(0) {}
+            Amount(std::size_t size, std::size_t capacity) : size(size), capacity(capacity) {}
+
+            Amount &
+            operator+=(const Amount & other)
+            {
+                this->size += other.size;
+                this->capacity += other.capacity;
+                return *this;
+            }
+        };
+
+        /// Memory held by one element block
+        struct Block {
+            /// Element tags
+            Amount element_tags;
+            /// Node tags of all elements
+            Amount connectivity;
+        };
+
+        /// `Node` objects
+        Amount nodes;
+        /// Node tags
+        Amount node_tags;
+        /// Node coordinates
+        Amount coordinates;
+        /// Parametric coordinates
+        Amount par_coords;
+        /// `ElementBlock` objects
+        Amount element_blocks;
+        /// Element blocks in the same order as `get_element_blocks`
+        std::vector<Block> blocks;
+        /// Point, curve, surface and volume entities (including their tag lists)
+        Amount entities;
+        /// Physical names
+        Amount names;
+        /// Node blocks kept by `reset` for the next file (the `Node` objects and their buffers;
+        /// the buffers are empty, so they count only towards the capacity)
+        Amount spare_nodes;
+        /// Element blocks kept by `reset` for the next file (the `ElementBlock` objects and their
+        /// buffers)
+        Amount spare_element_blocks;
+
+        /// Get the total amount of memory
+        Amount total() const;
+    };
+
+    /// Progress callback
+    ///
+    /// Called with the number of bytes consumed so far and the total number of bytes (0 if unknown,
+    /// e.g. for streams and compressed inputs). Returning `false` cancels parsing.
+    using ProgressCallback = std::function<bool(std::size_t num_bytes, std::size_t total_bytes)>;
+
+    /// Construct MSH file without any input
+    ///
+    /// Use `open` to bind an input before parsing.
+    ///
+    /// @param resource Memory resource for the parsed data
+    explicit MshFile(std::pmr::memory_resource * resource = std::pmr::get_default_resource());
+
     /// Construct MSH file
     ///
+    /// Files compressed with gzip or zstd are decompressed on the fly when the library is built
+    /// with zlib or zstd support, respectively.
+    ///
     /// @param file_name The MSH file name
-    explicit MshFile(const std::string & file_name);
+    /// @param resource Memory resource for the parsed data
+    explicit MshFile(const std::string & file_name,
+                     std::pmr::memory_resource * resource = std::pmr::get_default_resource());
+
+    /// Construct MSH file from an input stream
+    ///
+    /// The stream must stay alive until parsing is done. Data is read sequentially, so pipes and
+    /// other non-seekable streams are fine. Compressed data is handled the same way as for files.
+    ///
+    /// @param stream Input stream with the MSH data
+    /// @param resource Memory resource for the parsed data
+    explicit MshFile(std::istream & stream,
+                     std::pmr::memory_resource * resource = std::pmr::get_default_resource());
+
+    /// Construct MSH file from an in-memory buffer
+    ///
+    /// The data is not copied and must stay alive until parsing is done.
+    ///
+    /// @param data Pointer to the MSH data
+    /// @param size Size of the data in bytes
+    /// @param resource Memory resource for the parsed data
+    MshFile(const char * data,
+            std::size_t size,
+            std::pmr::memory_resource * resource = std::pmr::get_default_resource());
 
     virtual ~MshFile();
 
+    /// Open a file, replacing the current input
+    ///
+    /// Same as `reset` followed by binding `file_name` the way the constructor does. Settings (read
+    /// ahead, number of threads, statistics, progress callback) are kept.
+    ///
+    /// @param file_name The MSH file name
+    void open(const std::string & file_name);
+
+    /// Open an input stream, replacing the current input
+    ///
+    /// @param stream Input stream with the MSH data
+    void open(std::istream & stream);
+
+    /// Open an in-memory buffer, replacing the current input
+    ///
+    /// @param data Pointer to the MSH data
+    /// @param size Size of the data in bytes
+    void open(const char * data, std::size_t size);
+
+    /// Drop the input and all parsed data
+    ///
+    /// Containers are cleared rather than freed, so parsing another file into this object reuses
+    /// the memory already allocated. This includes the buffers of node and element blocks (tags,
+    /// coordinates, connectivity), which are kept aside and handed to the blocks of the next file.
+    /// At most 1024 node blocks and 1024 element blocks are kept (v2 files have one node block per
+    /// node); the memory they retain is reported by `memory_usage` and can be freed with
+    /// `release_spare`.
+    void reset();
+
+    /// Free the node and element blocks (and their buffers) kept aside for the next file
+    void release_spare();
+
+    /// Get the memory resource holding the parsed data
+    ///
+    /// All containers with parsed data (nodes, element blocks, entities, ...) allocate from it, so
+    /// it can be e.g. a monotonic arena released in one go once the mesh is no longer needed. It
+    /// must outlive this object and any data moved out of it. Note that allocations can happen
+    /// from multiple threads only if the resource is thread-safe, which is not the case for the
+    /// standard monotonic and unsynchronized pool resources; the parallel decoder therefore
+    /// allocates on the calling thread only.
+    ///
+    /// When built with GMSHPARSERCPP_COUNT_ALLOCATIONS, this is a counting pass-through resource
+    /// of this object sitting on top of the resource given to the constructor. It stays alive as
+    /// long as data moved out of this object does.
+    ///
+    /// @return Memory resource
+    std::pmr::memory_resource * get_memory_resource() const;
+
     /// Get file format version
     ///
     /// @return File format version
@@ -155,41 +610,166 @@ public:
     /// Get physical names
     ///
     /// @return List of physical names
-    const std::vector<PhysicalName> & get_physical_names() const;
+    const std::pmr::vector<PhysicalName> & get_physical_names() const;
 
     /// Get point entities
     ///
     /// @return List of point entities
-    const std::vector<PointEntity> & get_point_entities() const;
+    const std::pmr::vector<PointEntity> & get_point_entities() const;
 
     /// Get curve entities
     ///
     /// @return List of curve entities
-    const std::vector<MultiDEntity> & get_curve_entities() const;
+    const std::pmr::vector<MultiDEntity> & get_curve_entities() const;
 
     /// Get surface entities
     ///
     /// @return List of surface entities
-    const std::vector<MultiDEntity> & get_surface_entities() const;
+    const std::pmr::vector<MultiDEntity> & get_surface_entities() const;
 
     /// Get volume entities
     ///
     /// @return List of volume entities
-    const std::vector<MultiDEntity> & get_volume_entities() const;
+    const std::pmr::vector<MultiDEntity> & get_volume_entities() const;
 
     /// Get nodes
     ///
     /// @return List of nodes
-    const std::vector<Node> & get_nodes() const;
+    const std::pmr::vector<Node> & get_nodes() const;
 
     /// Get element blocks
     ///
     /// @return List of element blocks
-    const std::vector<ElementBlock> & get_element_blocks() const;
+    const std::pmr::vector<ElementBlock> & get_element_blocks() const;
+
+    /// Move physical names out of the file
+    ///
+    /// The file is left without physical names. The returned container keeps allocating from the
+    /// memory resource of the file.
+    ///
+    /// @return List of physical names
+    std::pmr::vector<PhysicalName> take_physical_names();
+
+    /// Move point entities out of the file
+    ///
+    /// @return List of point entities
+    std::pmr::vector<PointEntity> take_point_entities();
+
+    /// Move curve entities out of the file
+    ///
+    /// @return List of curve entities
+    std::pmr::vector<MultiDEntity> take_curve_entities();
+
+    /// Move surface entities out of the file
+    ///
+    /// @return List of surface entities
+    std::pmr::vector<MultiDEntity> take_surface_entities();
+
+    /// Move volume entities out of the file
+    ///
+    /// @return List of volume entities
+    std::pmr::vector<MultiDEntity> take_volume_entities();
+
+    /// Move nodes out of the file
+    ///
+    /// The file is left without nodes, no data is copied.
+    ///
+    /// @return List of nodes
+    std::pmr::vector<Node> take_nodes();
+
+    /// Move element blocks out of the file
+    ///
+    /// The file is left without element blocks, no data is copied.
+    ///
+    /// @return List of element blocks
+    std::pmr::vector<ElementBlock> take_element_blocks();
+
+    /// Move all parsed data out of the file
+    ///
+    /// Equivalent to calling all the `take_*` methods. No data is copied.
+    ///
+    /// @return Parsed mesh data
+    Mesh release();
+
+    /// Read the input ahead of the parser on a background thread
+    ///
+    /// Reading (and decompressing) the input then overlaps with decoding it. Must be called before
+    /// `parse`.
+    ///
+    /// @param block_size Size of one read-ahead block in bytes, 0 disables read-ahead
+    /// @param num_blocks Number of blocks, 2 gives double buffering
+    void set_read_ahead(std::size_t block_size, std::size_t num_blocks = 2);
+
+    /// Set the number of threads used for decoding binary v4 files
+    ///
+    /// Entity blocks in `$Nodes` and `$Elements` sections are then read as raw bytes (their size
+    /// follows from the block header) and decoded concurrently, while the next block is being read.
+    /// Must be called before `parse`.
+    ///
+    /// @param n Number of threads, 0 means one per hardware thread, 1 (default) decodes serially
+    void set_num_threads(unsigned int n);
+
+    /// Set the precision node coordinates are stored in
+    ///
+    /// With `Precision::SINGLE`, coordinates and parametric coordinates go into
+    /// `Node::float_coordinates` and `Node::float_par_coords` (converted as they are decoded) and
+    /// `Node::coordinates` and `Node::par_coords` stay empty (use `Node::get_float_par_coords`
+    /// instead of `Node::get_par_coords`). Must be called before `parse`.
+    ///
+    /// @param precision Precision of the stored coordinates, `Precision::DOUBLE` by default
+    void set_coordinate_precision(Precision precision);
+
+    /// Set if parametric coordinates are stored
+    ///
+    /// When the CAD parametrization is not needed, parametric coordinates are skipped while
+    /// parsing and `Node::par_coords` (`Node::float_par_coords`) stays empty; `Node::parametric`
+    /// still tells if the file has them, while `Node::get_par_coords` and
+    /// `Node::get_float_par_coords` return `nullptr`. Must be called before `parse`.
+    ///
+    /// @param state `true` (default) to store parametric coordinates, `false` to skip them
+    void set_read_par_coords(bool state);
+
+    /// Record per-section statistics while parsing
+    ///
+    /// Must be called before `parse`.
+    ///
+    /// @param state `true` to record statistics, `false` otherwise
+    void set_collect_stats(bool state);
+
+    /// Get parse statistics
+    ///
+    /// @return Statistics recorded by `parse` (empty unless enabled by `set_collect_stats`)
+    const ParseStats & get_stats() const;
+
+    /// Set progress callback
+    ///
+    /// The callback is invoked from `parse` every time at least `interval` more bytes were
+    /// consumed, and once at the end. The return value of the final call is ignored, since the
+    /// input was parsed completely by then. Must be called before `parse`.
+    ///
+    /// @param callback Callback function
+    /// @param interval Minimal number of bytes between two calls
+    void set_progress_callback(ProgressCallback callback, std::size_t interval = 1 << 20);
+
+    /// Cancel parsing
+    ///
+    /// Can be called from any thread (or from the progress callback). `parse` then throws
+    /// `CancelledException` at its next progress check. Progress is checked between sections
+    /// and every time the progress interval (1 MiB by default, see `set_progress_callback`) was
+    /// consumed within a section, so cancellation is coarse: up to an interval of input (plus the
+    /// block decodes already queued with multiple threads) is still processed. The last check
+    /// follows the last section; a cancellation arriving after it (e.g. from the final progress
+    /// callback) has no effect and `parse` returns normally.
+    void cancel();
 
     /// Parse the file
     void parse();
 
+    /// Get the amount of memory held by the parsed data and by the blocks kept for reuse
+    ///
+    /// @return Breakdown of the memory usage
+    MemoryUsage memory_usage() const;
+
     /// Close the file
     void close();
 
@@ -213,18 +793,83 @@ protected:
     void process_nodes_section();
     void process_nodes_section_v2();
     void process_nodes_section_v4();
+    void process_nodes_section_v4_parallel(std::size_t num_entity_blocks);
     void process_elements_section();
     void process_elements_section_v2();
     void process_elements_section_v4();
-    std::vector<int> process_array_of_ints();
+    void process_elements_section_v4_parallel(std::size_t num_entity_blocks);
+    /// Read a block payload for the parallel decoder
+    ///
+    /// Waits for the blocks queued on `pool` first if too much payload data is in flight.
+    std::shared_ptr<std::vector<char>> read_payload(ThreadPool & pool, std::size_t n_bytes);
+    /// Wait for the blocks queued on `pool` by the parallel decoder
+    void wait_for_payloads(ThreadPool & pool);
+    void process_array_of_ints(std::pmr::vector<int> & array);
     void skip_section();
     void read_end_section_marker(const std::string & section_name);
-    ElementBlock & get_element_block_by_tag_create(int dim, int tag);
-
+    ElementBlock & get_element_block_by_tag_create(int dim, int tag, ElementType type);
+    /// Append an empty node block, reusing a spare one (and its buffers) if there is any
+    Node & add_node_block();
+    /// Append an empty element block, reusing a spare one (and its buffers) if there is any
+    ElementBlock & add_element_block();
+
+    /// Report progress if enough data was consumed since the last report
+    void
+    check_progress()
+    {
+        if (this->lexer.get_num_bytes() >= this->next_progress)
+            report_progress();
+    }
+
+    /// Call the progress callback and check for cancellation
+    void report_progress();
+    /// Set up the input stream on top of `src`, inserting a decompressor if needed
+    void set_input(std::streambuf * src);
+
+    /// Memory resource for the parsed data
+    std::pmr::memory_resource * resource;
     /// File name
     std::string file_name;
-    /// Input stream
+    /// File stream
     std::ifstream file;
+    /// Stream buffer over the in-memory data (when parsing from memory)
+    std::unique_ptr<std::streambuf> memory_buf;
+    /// Decompressing stream buffer sitting on top of the raw input (for compressed inputs)
+    std::unique_ptr<std::streambuf> decompressor;
+    /// Read-ahead stream buffer sitting on top of the (decompressed) input
+    std::unique_ptr<ReadAheadStreamBuf> read_ahead;
+    /// Size of one read-ahead block in bytes (0 means no read-ahead)
+    std::size_t read_ahead_block_size;
+    /// Number of read-ahead blocks
+    std::size_t read_ahead_num_blocks;
+    /// Number of threads for decoding binary v4 files
+    unsigned int num_threads;
+    /// Precision of the stored coordinates
+    Precision coordinate_precision;
+    /// Flag indicating if parametric coordinates are stored
+    bool read_par_coords;
+    /// Flag indicating if statistics are recorded
+    bool collect_stats;
+    /// Parse statistics
+    ParseStats stats;
+    /// Number of values decoded outside of the lexer (by the parallel decoder)
+    std::size_t num_bulk_values;
+    /// Number of payload bytes queued for the parallel decoder since it last waited
+    std::size_t payload_bytes_in_flight;
+    /// Flag indicating that the last processed section was skipped
+    bool section_skipped;
+    /// Size of the input in bytes (0 if unknown)
+    std::size_t input_size;
+    /// Progress callback
+    ProgressCallback progress_callback;
+    /// Number of bytes between progress reports
+    std::size_t progress_interval;
+    /// Number of consumed bytes at which progress is reported next
+    std::size_t next_progress;
+    /// Flag indicating that parsing was cancelled
+    std::atomic<bool> cancelled;
+    /// Input stream
+    std::istream in;
     /// Lexer for lexicographic analysis
     MshLexer lexer;
     /// File format version
@@ -234,19 +879,23 @@ protected:
     /// Endianness for binary files
     int endianness;
     /// Physical names
-    std::vector<PhysicalName> physical_names;
+    std::pmr::vector<PhysicalName> physical_names;
     /// Point entities
-    std::vector<PointEntity> point_entities;
+    std::pmr::vector<PointEntity> point_entities;
     /// Curve entities
-    std::vector<MultiDEntity> curve_entities;
+    std::pmr::vector<MultiDEntity> curve_entities;
     /// Surface entities
-    std::vector<MultiDEntity> surface_entities;
+    std::pmr::vector<MultiDEntity> surface_entities;
     /// Volume entities
-    std::vector<MultiDEntity> volume_entities;
+    std::pmr::vector<MultiDEntity> volume_entities;
     /// Nodes
-    std::vector<Node> nodes;
+    std::pmr::vector<Node> nodes;
     /// Element blocks
-    std::vector<ElementBlock> element_blocks;
+    std::pmr::vector<ElementBlock> element_blocks;
+    /// Emptied node blocks of the previous file, reused by `add_node_block`
+    std::pmr::vector<Node> spare_nodes;
+    /// Emptied element blocks of the previous file, reused by `add_element_block`
+    std::pmr::vector<ElementBlock> spare_element_blocks;
 };
 
 } // namespace gmshparsercpp
@@ -3,11 +3,16 @@
 
 #pragma once
 
-#include <fstream>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <vector>
 #include "gmshparsercpp/Exception.h"
 
 namespace gmshparsercpp {
 
+struct TokenScanner;
+
 class MshLexer {
 public:
     struct Token {
@@ -28,10 +33,13 @@ public:
         }
     };
 
-    explicit MshLexer(std::ifstream * in);
+    explicit MshLexer(std::istream * in);
 
     void set_binary(bool state);
 
+    /// Forget the state of the previous input (peeked token, binary mode and counters)
+    void reset();
+
     /// Look at the next token awaiting in the input stream
     Token peek();
 
@@ -44,36 +52,124 @@ public:
     read_blob()
     {
         T val;
-        this->in->read((char *) &val, sizeof(T));
+        read_bytes(reinterpret_cast<char *>(&val), sizeof(T));
         return val;
     }
 
+    /// Read raw bytes from the input stream
+    ///
+    /// @param data Buffer receiving the bytes
+    /// @param size Number of bytes to read
+    void
+    read_bytes(char * data, std::size_t size)
+    {
+        if (this->end - this->pos >= size) {
+            std::memcpy(data, this->buffer.data() + this->pos, size);
+            consume(size);
+        }
+        else
+            read_bytes_slow(data, size);
+    }
+
     template <typename T>
     T
     get()
     {
+        T val;
+        get(&val, 1);
+        return val;
+    }
+
+    /// Read values
+    ///
+    /// Same as calling `get<T>` `n` times. In ASCII mode, tokens are located in bulk by a
+    /// (vectorized) scanner and decoded directly from the input buffer.
+    ///
+    /// @param values Array receiving the values
+    /// @param n Number of values to read
+    template <typename T>
+    void
+    get(T * values, std::size_t n)
+    {
+        this->num_values += n;
         if (this->binary)
-            return read_blob<T>();
+            read_bytes(reinterpret_cast<char *>(values), n * sizeof(T));
         else
-            return read().as<T>();
+            read_ascii(values, n);
+    }
+
+    /// Get the number of bytes read from the input stream so far
+    std::size_t
+    get_num_bytes() const
+    {
+        return this->num_bytes;
+    }
+
+    /// Get the number of tokens read so far
+    std::size_t
+    get_num_tokens() const
+    {
+        return this->num_tokens;
+    }
+
+    /// Get the number of values decoded via `get` so far
+    std::size_t
+    get_num_values() const
+    {
+        return this->num_values;
     }
 
 private:
+    /// Make sure the next token is cached in `curr`
+    void fetch();
     /// Read a token from an input stream
     Token read_token();
-    /// Look at a character from an input stream without reading it
-    int peek_char();
-    /// Read a character from an input stream
-    char read_char();
+    /// Read ASCII values (int, size_t and double are supported)
+    template <typename T>
+    void read_ascii(T * values, std::size_t n);
+    /// Read raw bytes that are not all in the buffer yet
+    void read_bytes_slow(char * data, std::size_t size);
+    /// Read more input into the buffer, keeping the unconsumed data
+    ///
+    /// @return `false` if the end of the input was reached and no data was added
+    bool fill();
+
+    /// Mark bytes at the start of the buffer as consumed
+    void
+    consume(std::size_t n)
+    {
+        this->pos += n;
+        this->num_bytes += n;
+    }
 
     /// Input stream
-    std::ifstream * in;
+    std::istream * in;
+    /// Scanner locating tokens
+    const TokenScanner * scanner;
+    /// Input buffer
+    std::vector<char> buffer;
+    /// Position of the first unconsumed byte in `buffer`
+    std::size_t pos;
+    /// End of valid data in `buffer`
+    std::size_t end;
+    /// Flag indicating that the end of the input stream was reached
+    bool eof;
+    /// Start offsets of tokens located by the scanner
+    std::vector<std::uint32_t> token_starts;
+    /// End offsets of tokens located by the scanner
+    std::vector<std::uint32_t> token_ends;
     /// Flag indicating if we have a token cached
     bool have_token;
     /// Cached token
     Token curr;
     ///
     bool binary;
+    /// Number of bytes consumed
+    std::size_t num_bytes;
+    /// Number of tokens read
+    std::size_t num_tokens;
+    /// Number of values decoded
+    std::size_t num_values;
 };
 
 template <>
@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <exception>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <memory_resource>
+#include <thread>
+#include "gmshparsercpp/MshFile.h"
+
+namespace gmshparsercpp {
+
+class PipeStreamBuf;
+
+/// Parser that is fed MSH data in chunks of arbitrary size
+///
+/// This is a threaded adapter around the pull parser, not a state machine: chunks are handed over
+/// to an `MshFile` parsing on a background thread, so receiving data and parsing it overlap. Chunk
+/// boundaries can fall anywhere, including in the middle of a token or a binary value. Only a
+/// bounded amount of data is queued. `feed` blocks while the parser catches up; `try_feed` never
+/// blocks and takes only what fits, which suits event loops.
+class MshPushParser {
+public:
+    /// Callback setting up the parser before the data arrives
+    using SetupCallback = std::function<void(MshFile & file)>;
+
+    /// Construct push parser
+    ///
+    /// @param capacity Maximum number of bytes queued for the parser
+    /// @param resource Memory resource for the parsed data, see `MshFile::get_memory_resource`
+    explicit MshPushParser(std::size_t capacity = 1 << 22,
+                           std::pmr::memory_resource * resource = std::pmr::get_default_resource());
+
+    virtual ~MshPushParser();
+
+    /// Set a callback configuring the parser (number of threads, coordinate precision, ...)
+    ///
+    /// Must be called before the first chunk is fed. The callback runs on the parser thread.
+    ///
+    /// @param setup Callback called once before parsing
+    void set_setup_callback(SetupCallback setup);
+
+    /// Feed a chunk of data to the parser
+    ///
+    /// Blocks while the queue is full. If the parser failed, the error is re-thrown from here.
+    ///
+    /// @param data Pointer to the data (copied, can be reused once the call returns)
+    /// @param size Number of bytes
+    void feed(const char * data, std::size_t size);
+
+    /// Feed as much of a chunk as fits into the queue without blocking
+    ///
+    /// If the parser failed, the error is re-thrown from here.
+    ///
+    /// @param data Pointer to the data (copied, can be reused once the call returns)
+    /// @param size Number of bytes
+    /// @return Number of bytes taken; less than `size` (possibly 0) if the queue is full, in which
+    ///         case the rest has to be fed again later
+    std::size_t try_feed(const char * data, std::size_t size);
+
+    /// Signal the end of the input and wait until parsing is done
+    ///
+    /// If the parser failed, the error is re-thrown from here.
+    void finish();
+
+    /// Get the parsed file
+    ///
+    /// @return Parsed MSH file. Only available after `finish` returned.
+    const MshFile & get_file() const;
+
+    /// Move all parsed data out of the parser
+    ///
+    /// Only available after `finish` returned. No data is copied, see `MshFile::release`.
+    ///
+    /// @return Parsed mesh data
+    MshFile::Mesh release();
+
+private:
+    /// Start the parser thread, if not running yet
+    void start();
+    /// Join the parser thread and re-throw its error, if any
+    void join();
+
+    /// Pipe the data travels through
+    std::unique_ptr<PipeStreamBuf> pipe;
+    /// Stream the parser reads from
+    std::istream stream;
+    /// Parser (bound to `stream` on the parser thread)
+    std::unique_ptr<MshFile> file;
+    /// Callback configuring `file`
+    SetupCallback setup;
+    /// Parser thread
+    std::thread thread;
+    /// Error raised by the parser thread
+    std::exception_ptr error;
+    /// Flag indicating that the parser thread was started
+    bool started;
+    /// Flag indicating that `finish` was called
+    bool finished;
+    /// Flag indicating that parsing completed without an error
+    bool done;
+};
+
+} // namespace gmshparsercpp
@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "gmshparsercpp/MshFile.h"
+
+namespace gmshparsercpp {
+
+/// Order nodes are renumbered in
+enum class NodeOrdering {
+    /// Reverse Cuthill-McKee, minimizes the bandwidth of matrices assembled over the elements
+    RCM,
+    /// Morton (Z-order) curve through the node coordinates
+    MORTON,
+    /// Hilbert curve through the node coordinates
+    HILBERT
+};
+
+/// Where renumbered nodes are stored
+enum class NodeLayout {
+    /// Nodes stay in their node blocks, which are sorted by the new tags
+    KEEP_BLOCKS,
+    /// Nodes of all blocks are merged into a single node block in the new order
+    MERGE
+};
+
+/// Renumber nodes for locality
+///
+/// Nodes get new tags so that numbering them by increasing tag follows `ordering`; the set of tags
+/// stays the same (with tags `1..n`, the `k`-th node in the new order gets tag `k + 1`).
+/// Connectivity of all element blocks is rewritten to the new tags.
+///
+/// With `NodeLayout::KEEP_BLOCKS`, nodes stay in their node blocks (so they keep their entity),
+/// but the nodes of each block (tags, coordinates and parametric coordinates) are permuted to
+/// increasing tag order. Coordinates move only within their block, so there is little gain in
+/// locality when the mesh has many node blocks (v2 files have one block per node).
+///
+/// With `NodeLayout::MERGE`, all nodes are moved into a single node block in the new order, so
+/// coordinates are laid out in memory along `ordering`. The block gets the largest dimension of the
+/// original blocks; entities and parametric coordinates are dropped.
+///
+/// Meant to be run after parsing, on the containers obtained from `MshFile::release` (or
+/// `MshFile::take_nodes` and `MshFile::take_element_blocks`).
+///
+/// @param nodes Node blocks
+/// @param blocks Element blocks
+/// @param ordering Order to renumber nodes in
+/// @param num_threads Number of threads, 0 means one per hardware thread
+/// @param layout Where renumbered nodes are stored
+/// @return Permutation: `perm[k]` is the (original) position of the `k`-th node in the new order,
+///         positions counting nodes of all node blocks in order. Throws if the connectivity
+///         references an unknown node tag, before anything is modified.
+std::vector<std::size_t> reorder_nodes(std::pmr::vector<MshFile::Node> & nodes,
+                                       std::pmr::vector<MshFile::ElementBlock> & blocks,
+                                       NodeOrdering ordering,
+                                       unsigned int num_threads = 0,
+                                       NodeLayout layout = NodeLayout::KEEP_BLOCKS);
+
+/// Sort the elements of each block along a Hilbert curve
+///
+/// Elements are keyed by the position of their centroid (the average of their corner nodes) along
+/// a Hilbert curve through the bounding box of all nodes and sorted with a parallel radix sort.
+/// Element tags move with the elements, i.e. elements are not renumbered, only stored in a
+/// different order, so that neighboring elements are close in memory.
+///
+/// @param nodes Node blocks
+/// @param blocks Element blocks to sort
+/// @param num_threads Number of threads, 0 means one per hardware thread
+/// @return Permutation of each block: `perms[b][i]` is the original index of the element now at
+///         index `i` of block `b`. Throws if a block has an unknown element type or references
+///         an unknown node tag, before anything is modified.
+std::vector<std::vector<std::size_t>>
+reorder_elements(const std::pmr::vector<MshFile::Node> & nodes,
+                 std::pmr::vector<MshFile::ElementBlock> & blocks,
+                 unsigned int num_threads = 0);
+
+} // namespace gmshparsercpp
@@ -0,0 +1,290 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "gmshparsercpp/MshFile.h"
+
+namespace gmshparsercpp {
+
+/// Relation stored in compressed sparse row (CSR) format
+///
+/// Row `i` holds `indices[offsets[i]]` up to (excluding) `indices[offsets[i + 1]]`. For graphs,
+/// `offsets` and `indices` are what partitioners call `xadj` and `adjncy`.
+struct Csr {
+    /// Start of each row in `indices`, one more entry than there are rows
+    std::vector<std::size_t> offsets;
+    /// Column indices of all rows
+    std::vector<std::size_t> indices;
+
+    /// Get the number of rows
+    std::size_t
+    size() const
+    {
+        return this->offsets.empty() ? 0 : this->offsets.size() - 1;
+    }
+
+    /// Get the number of entries in a row
+    ///
+    /// @param i Row index
+    std::size_t
+    degree(std::size_t i) const
+    {
+        return this->offsets[i + 1] - this->offsets[i];
+    }
+
+    /// Get the first entry of a row
+    ///
+    /// @param i Row index
+    const std::size_t *
+    begin(std::size_t i) const
+    {
+        return this->indices.data() + this->offsets[i];
+    }
+
+    /// Get the end of a row
+    ///
+    /// @param i Row index
+    const std::size_t *
+    end(std::size_t i) const
+    {
+        return this->indices.data() + this->offsets[i + 1];
+    }
+};
+
+/// Dense numbering of nodes
+///
+/// Nodes are numbered `0, 1, ...` in the order they appear in the node blocks. When the tags span a
+/// range of at most `DENSE_RANGE_FACTOR` times the number of nodes, tags are looked up in a table
+/// spanning that range. Otherwise (e.g. a few nodes with tags `1` and `2^31 - 1`), tags are looked
+/// up by binary search in the sorted tags, so memory stays proportional to the number of nodes.
+class NodeNumbering {
+public:
+    /// Value returned by `find` for unknown tags
+    static constexpr std::size_t INVALID = std::numeric_limits<std::size_t>::max();
+    /// Largest ratio of the tag range to the number of nodes that uses a lookup table
+    static constexpr std::size_t DENSE_RANGE_FACTOR = 4;
+
+    /// Number the nodes of all node blocks
+    ///
+    /// @param nodes Node blocks
+    explicit NodeNumbering(const std::pmr::vector<MshFile::Node> & nodes);
+
+    /// Get the number of nodes
+    std::size_t
+    size() const
+    {
+        return this->tags.size();
+    }
+
+    /// Get the index of a node
+    ///
+    /// @param tag Node tag
+    /// @return Node index, `INVALID` if there is no node with `tag`
+    std::size_t
+    find(int tag) const
+    {
+        if (this->sorted.empty()) {
+            auto i = static_cast<std::size_t>(static_cast<long long>(tag) - this->min_tag);
+            return i < this->indices.size() ? this->indices[i] : INVALID;
+        }
+        else
+            return find_sorted(tag);
+    }
+
+    /// Check if tags are looked up in a table spanning the range of tags
+    bool
+    is_dense() const
+    {
+        return this->sorted.empty();
+    }
+
+    /// Get the index of a node
+    ///
+    /// @param tag Node tag
+    /// @return Node index, throws if there is no node with `tag`
+    std::size_t index(int tag) const;
+
+    /// Get the tag of a node
+    ///
+    /// @param index Node index
+    /// @return Node tag
+    int
+    tag(std::size_t index) const
+    {
+        return this->tags[index];
+    }
+
+private:
+    /// Look up a tag in `sorted`
+    std::size_t find_sorted(int tag) const;
+
+    /// Node tags in index order
+    std::vector<int> tags;
+    /// Index of each tag, offset by `min_tag` (dense lookup)
+    std::vector<std::size_t> indices;
+    /// Pairs of tag and index sorted by tag (sparse lookup)
+    std::vector<std::pair<int, std::size_t>> sorted;
+    /// Smallest tag
+    long long min_tag;
+};
+
+/// Consecutive numbering of the elements of selected element blocks
+///
+/// Element `e` of the selection is element `e - offset(k)` of the `k`-th selected block.
+class ElementNumbering {
+public:
+    /// Number the elements of some element blocks
+    ///
+    /// @param blocks Element blocks, must outlive this object
+    /// @param selection Indices of the selected blocks (in this order), empty to select all
+    explicit ElementNumbering(const std::pmr::vector<MshFile::ElementBlock> & blocks,
+                              const std::vector<std::size_t> & selection = {});
+
+    /// Get the number of elements
+    std::size_t
+    size() const
+    {
+        return this->offsets.back();
+    }
+
+    /// Get the number of selected blocks
+    std::size_t
+    num_blocks() const
+    {
+        return this->selection.size();
+    }
+
+    /// Get a selected block
+    ///
+    /// @param k Index within the selection
+    const MshFile::ElementBlock &
+    block(std::size_t k) const
+    {
+        return (*this->blocks)[this->selection[k]];
+    }
+
+    /// Get the index of a selected block in the list of element blocks
+    ///
+    /// @param k Index within the selection
+    std::size_t
+    block_index(std::size_t k) const
+    {
+        return this->selection[k];
+    }
+
+    /// Get the number of the first element of a selected block
+    ///
+    /// @param k Index within the selection
+    std::size_t
+    offset(std::size_t k) const
+    {
+        return this->offsets[k];
+    }
+
+    /// Find the selected block holding an element
+    ///
+    /// @param e Element number
+    /// @return Index within the selection
+    std::size_t find_block(std::size_t e) const;
+
+private:
+    /// All element blocks
+    const std::pmr::vector<MshFile::ElementBlock> * blocks;
+    /// Indices of the selected blocks
+    std::vector<std::size_t> selection;
+    /// Number of the first element of each selected block, plus the total
+    std::vector<std::size_t> offsets;
+};
+
+/// Build node-to-element adjacency
+///
+/// Row `i` lists (in increasing order) the elements using node `i`. Built in parallel with a
+/// counting pass, a prefix sum and a fill pass.
+///
+/// @param nodes Node numbering
+/// @param elements Elements to include
+/// @param num_threads Number of threads, 0 means one per hardware thread
+/// @return Inverse connectivity with one row per node
+Csr build_node_to_element(const NodeNumbering & nodes,
+                          const ElementNumbering & elements,
+                          unsigned int num_threads = 0);
+
+/// Build the node graph of a mesh (node-to-node adjacency)
+///
+/// Two nodes are neighbors if they belong to the same element, so this is the sparsity pattern of
+/// matrices assembled over the elements. Rows are sorted and do not contain the node itself.
+///
+/// @param nodes Node numbering
+/// @param elements Elements to include
+/// @param num_threads Number of threads, 0 means one per hardware thread
+/// @return Node graph with one row per node
+Csr build_node_graph(const NodeNumbering & nodes,
+                     const ElementNumbering & elements,
+                     unsigned int num_threads = 0);
+
+/// How two elements have to touch to be neighbors in the dual graph
+enum class DualGraphConnection {
+    /// Share a side: a face of 3D elements, an edge of 2D elements or a vertex of 1D elements
+    FACE,
+    /// Share an edge
+    EDGE,
+    /// Share a vertex
+    VERTEX
+};
+
+/// Build the dual graph of a mesh (element-to-element adjacency)
+///
+/// Only corner nodes are compared, so high-order elements work the same way as linear ones. For
+/// `FACE` and `EDGE`, sides of all elements are hashed, distributed into buckets by hash and
+/// matched bucket by bucket in parallel. `VERTEX` goes through node-to-element adjacency. Rows are
+/// sorted and do not contain the element itself, so the result can be handed to graph
+/// partitioners as `xadj` (`offsets`) and `adjncy` (`indices`).
+///
+/// @param nodes Node numbering
+/// @param elements Elements to include (graph vertices)
+/// @param connection Kind of shared entity making two elements neighbors
+/// @param num_threads Number of threads, 0 means one per hardware thread
+/// @return Dual graph with one row per element
+Csr build_dual_graph(const NodeNumbering & nodes,
+                     const ElementNumbering & elements,
+                     DualGraphConnection connection = DualGraphConnection::FACE,
+                     unsigned int num_threads = 0);
+
+/// Boundary sides of one element block
+///
+/// Sides are linear (built from corner nodes only), so they are `TRI3`/`QUAD4` faces of 3D
+/// elements, `LINE2` edges of 2D elements or `POINT`s ending 1D elements. Faces keep the
+/// orientation of the reference element, i.e. their normals point out of the parent element.
+struct BoundarySides {
+    /// Sides of one type as an element block with the tag of the parent block and element tags
+    /// numbered from 1 across all returned blocks
+    MshFile::ElementBlock block;
+    /// Index of the parent block within the element selection
+    std::size_t parent_block;
+    /// Parent element (number within the element selection) of each side
+    std::vector<std::size_t> parents;
+    /// Local index of each side within its parent (face index in `ReferenceTopology` for 3D
+    /// elements, edge index for 2D elements, corner index for 1D elements)
+    std::vector<int> local_sides;
+};
+
+/// Extract the boundary of a mesh
+///
+/// A side (face of a 3D element, edge of a 2D element or end point of a 1D element) is on the
+/// boundary if no other element has it. Sides are matched by hashing their sorted corner nodes,
+/// the same way `build_dual_graph` does, in parallel and storing 16 bytes per side.
+///
+/// @param nodes Node numbering
+/// @param elements Elements to extract the boundary of (usually blocks of the same dimension)
+/// @param num_threads Number of threads, 0 means one per hardware thread
+/// @return Boundary sides, one entry per selected block and side type (in this order)
+std::vector<BoundarySides> extract_boundary(const NodeNumbering & nodes,
+                                            const ElementNumbering & elements,
+                                            unsigned int num_threads = 0);
+
+} // namespace gmshparsercpp
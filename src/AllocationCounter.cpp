@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "AllocationCounter.h"
+#include <atomic>
+
+namespace gmshparsercpp {
+
+namespace {
+
+thread_local AllocationCount thread_allocations = { 0, 0 };
+
+/// Pass-through resource recording allocations
+///
+/// Reference counted by its owner and its live blocks; deletes itself when both are gone.
+class CountingResource : public std::pmr::memory_resource {
+public:
+    explicit CountingResource(std::pmr::memory_resource * upstream) : upstream(upstream), refs(1)
+    {
+    }
+
+    /// Drop one reference, deleting this resource with the last one
+    void
+    unref()
+    {
+        if (this->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete this;
+    }
+
+protected:
+    void *
+    do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        auto ptr = this->upstream->allocate(bytes, alignment);
+        this->refs.fetch_add(1, std::memory_order_relaxed);
+        count_allocation(bytes);
+        return ptr;
+    }
+
+    void
+    do_deallocate(void * ptr, std::size_t bytes, std::size_t alignment) override
+    {
+        this->upstream->deallocate(ptr, bytes, alignment);
+        unref();
+    }
+
+    bool
+    do_is_equal(const std::pmr::memory_resource & other) const noexcept override
+    {
+        return this == &other;
+    }
+
+private:
+    /// Resource doing the actual allocations
+    std::pmr::memory_resource * const upstream;
+    /// Number of references: the owner plus one per live block
+    std::atomic<std::size_t> refs;
+};
+
+} // namespace
+
+std::pmr::memory_resource *
+make_counting_resource(std::pmr::memory_resource * upstream)
+{
+    return new CountingResource(upstream);
+}
+
+void
+release_counting_resource(std::pmr::memory_resource * resource)
+{
+    static_cast<CountingResource *>(resource)->unref();
+}
+
+void
+count_allocation(std::size_t bytes)
+{
+    thread_allocations.count++;
+    thread_allocations.bytes += bytes;
+}
+
+void
+count_allocation(const std::string & str)
+{
+    static const std::size_t sso_capacity = std::string().capacity();
+    if (str.capacity() > sso_capacity)
+        count_allocation(str.capacity() + 1);
+}
+
+AllocationCount
+allocation_count()
+{
+    return thread_allocations;
+}
+
+} // namespace gmshparsercpp
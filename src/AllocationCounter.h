@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+
+namespace gmshparsercpp {
+
+/// Running totals of allocations
+struct AllocationCount {
+    /// Number of allocations
+    std::size_t count;
+    /// Number of bytes requested
+    std::size_t bytes;
+};
+
+/// Create a memory resource counting the allocations it forwards to `upstream`
+///
+/// Allocations are added to the totals of the allocating thread. The resource is kept alive by
+/// its owner and by every block allocated from it: it is destroyed once the owner has called
+/// `release_counting_resource` and the last block has been deallocated, so containers allocated
+/// from it can outlive the owner.
+///
+/// @param upstream Resource doing the actual allocations
+/// @return Counting resource
+std::pmr::memory_resource * make_counting_resource(std::pmr::memory_resource * upstream);
+
+/// Drop the owner's reference to a resource created by `make_counting_resource`
+///
+/// @param resource Counting resource
+void release_counting_resource(std::pmr::memory_resource * resource);
+
+/// Record an allocation that does not go through a counting resource
+///
+/// @param bytes Number of bytes requested
+void count_allocation(std::size_t bytes);
+
+/// Record the heap buffer of a string, if it does not fit into the small string buffer
+///
+/// @param str String
+void count_allocation(const std::string & str);
+
+/// Get the allocation totals of the calling thread
+///
+/// Only allocations made through a counting resource or recorded by `count_allocation` are
+/// counted; the global `operator new` is left alone.
+AllocationCount allocation_count();
+
+} // namespace gmshparsercpp
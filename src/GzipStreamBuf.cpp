@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "GzipStreamBuf.h"
+#include "gmshparsercpp/Exception.h"
+
+namespace gmshparsercpp {
+
+GzipStreamBuf::GzipStreamBuf(std::streambuf * src, std::size_t buffer_size) :
+    src(src),
+    strm(),
+    in_buf(buffer_size),
+    out_buf(buffer_size),
+    src_eof(false),
+    stream_end(false)
+{
+    // 15 window bits + 32 enables automatic gzip/zlib header detection
+    if (inflateInit2(&this->strm, 15 + 32) != Z_OK)
+        throw Exception("Failed to initialize zlib: {}", this->strm.msg ? this->strm.msg : "");
+    setg(this->out_buf.data(), this->out_buf.data(), this->out_buf.data());
+}
+
+GzipStreamBuf::~GzipStreamBuf()
+{
+    inflateEnd(&this->strm);
+}
+
+GzipStreamBuf::int_type
+GzipStreamBuf::underflow()
+{
+    if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+
+    while (true) {
+        if (this->strm.avail_in == 0 && !this->src_eof) {
+            auto n = this->src->sgetn(this->in_buf.data(), this->in_buf.size());
+            if (n <= 0)
+                this->src_eof = true;
+            this->strm.next_in = reinterpret_cast<Bytef *>(this->in_buf.data());
+            this->strm.avail_in = static_cast<uInt>(n > 0 ? n : 0);
+        }
+        if (this->strm.avail_in == 0 && this->src_eof && this->stream_end)
+            return traits_type::eof();
+
+        this->strm.next_out = reinterpret_cast<Bytef *>(this->out_buf.data());
+        this->strm.avail_out = static_cast<uInt>(this->out_buf.size());
+        auto ret = inflate(&this->strm, Z_NO_FLUSH);
+        if (ret == Z_STREAM_END) {
+            // concatenated gzip members are allowed
+            inflateReset(&this->strm);
+            this->stream_end = true;
+        }
+        else if (ret == Z_OK)
+            this->stream_end = false;
+        else if (ret == Z_BUF_ERROR) {
+            if (this->src_eof)
+                throw Exception("Unexpected end of compressed data.");
+        }
+        else
+            throw Exception("Failed to decompress data: {}", this->strm.msg ? this->strm.msg : "");
+
+        auto n_out = this->out_buf.size() - this->strm.avail_out;
+        if (n_out > 0) {
+            setg(this->out_buf.data(), this->out_buf.data(), this->out_buf.data() + n_out);
+            return traits_type::to_int_type(*gptr());
+        }
+    }
+}
+
+} // namespace gmshparsercpp
@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <streambuf>
+#include <vector>
+#include <zlib.h>
+
+namespace gmshparsercpp {
+
+/// Stream buffer that inflates gzip/zlib-compressed data read from another stream buffer
+///
+/// Only a bounded amount of compressed and decompressed data is held in memory at any time.
+class GzipStreamBuf : public std::streambuf {
+public:
+    /// Construct gzip stream buffer
+    ///
+    /// @param src Stream buffer with the compressed data
+    /// @param buffer_size Size of the internal buffers in bytes
+    explicit GzipStreamBuf(std::streambuf * src, std::size_t buffer_size = 1 << 16);
+    ~GzipStreamBuf() override;
+
+protected:
+    int_type underflow() override;
+
+private:
+    /// Source of the compressed data
+    std::streambuf * src;
+    /// zlib stream state
+    z_stream strm;
+    /// Compressed data
+    std::vector<char> in_buf;
+    /// Decompressed data
+    std::vector<char> out_buf;
+    /// Flag indicating that the source has no more data
+    bool src_eof;
+    /// Flag indicating that the last gzip member was fully decoded
+    bool stream_end;
+};
+
+} // namespace gmshparsercpp
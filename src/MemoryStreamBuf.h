@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <streambuf>
+
+namespace gmshparsercpp {
+
+/// Read-only stream buffer over a block of memory (no copy is made)
+class MemoryStreamBuf : public std::streambuf {
+public:
+    MemoryStreamBuf(const char * data, std::size_t size)
+    {
+        // std::streambuf wants mutable pointers, but we only ever read through them
+        auto begin = const_cast<char *>(data);
+        setg(begin, begin, begin + size);
+    }
+};
+
+} // namespace gmshparsercpp
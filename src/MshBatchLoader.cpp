@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "gmshparsercpp/MshBatchLoader.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+
+namespace gmshparsercpp {
+
+MshBatchLoader::MshBatchLoader(unsigned int num_threads) :
+    num_threads(ThreadPool::resolve_num_threads(num_threads))
+{
+}
+
+void
+MshBatchLoader::set_setup_callback(SetupCallback setup)
+{
+    this->setup = std::move(setup);
+}
+
+void
+MshBatchLoader::load(const std::vector<std::string> & file_names, const Callback & callback)
+{
+    auto n_workers = std::min<std::size_t>(this->num_threads, file_names.size());
+    if (n_workers == 0)
+        return;
+
+    ThreadPool pool(n_workers);
+    std::atomic<std::size_t> next(0);
+    std::atomic<bool> failed(false);
+    // one task per worker pulling files off a shared counter, so that each keeps its own parser
+    for (std::size_t w = 0; w < n_workers; w++) {
+        pool.submit([&]() {
+            MshFile file;
+            if (this->setup)
+                this->setup(file);
+            while (!failed) {
+                auto idx = next.fetch_add(1);
+                if (idx >= file_names.size())
+                    break;
+                try {
+                    file.open(file_names[idx]);
+                    file.parse();
+                    callback(idx, file);
+                }
+                catch (const std::exception & e) {
+                    failed = true;
+                    throw Exception("Failed to load '{}': {}", file_names[idx], e.what());
+                }
+            }
+        });
+    }
+    pool.wait();
+}
+
+} // namespace gmshparsercpp
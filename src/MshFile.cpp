@@ -2,25 +2,489 @@
 // SPDX-License-Identifier: MIT
 
 #include "gmshparsercpp/MshFile.h"
+#include "gmshparsercpp/ElementTraits.h"
+#include "AllocationCounter.h"
+#include "MemoryStreamBuf.h"
+#include "ReadAheadStreamBuf.h"
+#include "ThreadPool.h"
+#ifdef GMSHPARSERCPP_WITH_ZLIB
+    #include "GzipStreamBuf.h"
+#endif
+#ifdef GMSHPARSERCPP_WITH_ZSTD
+    #include "ZstdStreamBuf.h"
+#endif
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <limits>
 #include <system_error>
 
 namespace gmshparsercpp {
 
-MshFile::MshFile(const std::string & file_name) :
-    file_name(file_name),
-    file(this->file_name),
-    lexer(&this->file),
+namespace {
+
+/// Number of node rows decoded by one call to the lexer
+constexpr std::size_t NODE_ROWS_PER_BATCH = 256;
+/// Largest number of rows reserved up front from a count in the file (more rows grow the storage
+/// as they are read, so that a corrupt count cannot trigger a huge allocation)
+constexpr std::size_t MAX_RESERVED_ROWS = 1 << 20;
+/// Largest number of node blocks and of element blocks kept for reuse by the next file (v2 files
+/// have one node block per node, which would otherwise all be kept)
+constexpr std::size_t MAX_SPARE_BLOCKS = 1024;
+/// Clear a list of blocks, keeping its storage for the next file only if it is small
+template <typename T>
+void
+clear_block_list(std::pmr::vector<T> & blocks, std::pmr::memory_resource * resource)
+{
+    if (blocks.capacity() > MAX_SPARE_BLOCKS)
+        std::pmr::vector<T>(resource).swap(blocks);
+    else
+        blocks.clear();
+}
+
+/// Size of the chunks block payloads are read in by the parallel decoder
+constexpr std::size_t PAYLOAD_CHUNK_SIZE = 16 << 20;
+/// Number of payload bytes the parallel decoder queues before waiting for the queued blocks
+constexpr std::size_t MAX_PAYLOAD_BYTES_IN_FLIGHT = 64 << 20;
+
+/// Get the size of a block payload of `n_rows` rows of `row_size` bytes
+///
+/// Throws if the size does not fit into `std::size_t`, which no input can hold
+std::size_t
+payload_size(std::size_t n_rows, std::size_t row_size)
+{
+    if (row_size != 0 && n_rows > std::numeric_limits<std::size_t>::max() / row_size)
+        throw Exception("Corrupt block size: {} rows of {} bytes overflow", n_rows, row_size);
+    return n_rows * row_size;
+}
+
+enum class Compression { NONE, GZIP, ZSTD };
+
+/// Detect compression from the first byte of the input
+///
+/// The first bytes of the gzip (0x1f 0x8b) and zstd (0x28 0xb5 0x2f 0xfd) magic numbers can never
+/// start an MSH file, which begins with a section marker or white space, so a single byte of
+/// look-ahead is enough and works on non-seekable inputs, too.
+Compression
+detect_compression(std::streambuf * src)
+{
+    auto ch = src->sgetc();
+    if (ch == 0x1f)
+        return Compression::GZIP;
+    else if (ch == 0x28)
+        return Compression::ZSTD;
+    else
+        return Compression::NONE;
+}
+
+/// Read a value stored in binary form at `ptr`
+template <typename T>
+inline T
+load(const char * ptr)
+{
+    T val;
+    std::memcpy(&val, ptr, sizeof(T));
+    return val;
+}
+
+/// Append rows of coordinates followed by `n_par` parametric coordinates
+///
+/// Values are converted to the precision of `POINT`. Parametric coordinates are stored only if
+/// `store_par` is set.
+template <typename POINT>
+void
+append_rows(std::pmr::vector<POINT> & coords,
+            std::pmr::vector<decltype(POINT::x)> & par_coords,
+            bool store_par,
+            const double * rows,
+            std::size_t n_rows,
+            std::size_t n_par)
+{
+    using Real = decltype(POINT::x);
+    for (std::size_t i = 0; i < n_rows; i++, rows += 3 + n_par) {
+        coords.push_back(POINT(Real(rows[0]), Real(rows[1]), Real(rows[2])));
+        if (store_par)
+            par_coords.insert(par_coords.end(), rows + 3, rows + 3 + n_par);
+    }
+}
+
+/// Decode the raw data of a binary v4 node entity block
+///
+/// `node` must already be sized to hold `n` nodes in the precision of `POINT`. Parametric
+/// coordinates are skipped if `par_coords` is empty.
+template <typename POINT>
+void
+decode_node_block(MshFile::Node & node,
+                  std::pmr::vector<POINT> & coords,
+                  std::pmr::vector<decltype(POINT::x)> & par_coords,
+                  const char * data,
+                  std::size_t n)
+{
+    using Real = decltype(POINT::x);
+    auto n_par = node.get_num_par_coords();
+    auto par = par_coords.empty() ? nullptr : par_coords.data();
+    for (std::size_t i = 0; i < n; i++, data += sizeof(std::size_t))
+        node.tags[i] = load<std::size_t>(data);
+    for (std::size_t i = 0; i < n; i++) {
+        auto & pt = coords[i];
+        pt.x = Real(load<double>(data));
+        pt.y = Real(load<double>(data + sizeof(double)));
+        pt.z = Real(load<double>(data + 2 * sizeof(double)));
+        data += 3 * sizeof(double);
+        if (par)
+            for (std::size_t j = 0; j < n_par; j++)
+                *par++ = Real(load<double>(data + j * sizeof(double)));
+        data += n_par * sizeof(double);
+    }
+}
+
+/// Decode the raw data of a binary v4 element entity block
+///
+/// `blk` must already be sized to hold the elements
+void
+decode_element_block(MshFile::ElementBlock & blk, const char * data, std::size_t n_nodes_per_elem)
+{
+    auto conn = blk.connectivity.data();
+    for (auto & tag : blk.element_tags) {
+        tag = load<std::size_t>(data);
+        data += sizeof(std::size_t);
+        for (std::size_t k = 0; k < n_nodes_per_elem; k++, data += sizeof(std::size_t))
+            *conn++ = load<std::size_t>(data);
+    }
+}
+
+/// Move the contents out of a container, leaving it empty
+template <typename T>
+std::pmr::vector<T>
+take(std::pmr::vector<T> & vec)
+{
+    std::pmr::vector<T> out(std::move(vec));
+    vec.clear();
+    return out;
+}
+
+/// Get the resource the parsed data is allocated from
+std::pmr::memory_resource *
+data_resource(std::pmr::memory_resource * resource)
+{
+#ifdef GMSHPARSERCPP_COUNT_ALLOCATIONS
+    return make_counting_resource(resource);
+#else
+    return resource;
+#endif
+}
+
+/// Record an allocation made outside the memory resource (no-op when allocations are not counted)
+///
+/// @param what Number of bytes or a string whose heap buffer is recorded
+template <typename T>
+inline void
+record_allocation([[maybe_unused]] const T & what)
+{
+#ifdef GMSHPARSERCPP_COUNT_ALLOCATIONS
+    count_allocation(what);
+#endif
+}
+
+/// Current allocation totals (zeros when allocations are not counted)
+AllocationCount
+current_allocations()
+{
+#ifdef GMSHPARSERCPP_COUNT_ALLOCATIONS
+    return allocation_count();
+#else
+    return { 0, 0 };
+#endif
+}
+
+/// Memory held by the elements of a vector
+template <typename T, typename A>
+MshFile::MemoryUsage::Amount
+usage(const std::vector<T, A> & vec)
+{
+    return { vec.size() * sizeof(T), vec.capacity() * sizeof(T) };
+}
+
+/// Memory held by a string on the heap (nothing when the small string optimization kicks in)
+MshFile::MemoryUsage::Amount
+usage(const std::string & str)
+{
+    auto obj = reinterpret_cast<const char *>(&str);
+    if (str.data() >= obj && str.data() < obj + sizeof(std::string))
+        return {};
+    return { str.size() + 1, str.capacity() + 1 };
+}
+
+/// Memory held by the buffers of a node block
+MshFile::MemoryUsage::Amount
+usage(const MshFile::Node & node)
+{
+    auto amount = usage(node.tags);
+    amount += usage(node.coordinates);
+    amount += usage(node.float_coordinates);
+    amount += usage(node.par_coords);
+    amount += usage(node.float_par_coords);
+    return amount;
+}
+
+/// Memory held by the buffers of an element block
+MshFile::MemoryUsage::Amount
+usage(const MshFile::ElementBlock & blk)
+{
+    auto amount = usage(blk.element_tags);
+    amount += usage(blk.connectivity);
+    return amount;
+}
+
+MshFile::MemoryUsage::Amount
+usage(const MshFile::PointEntity & ent)
+{
+    return usage(ent.physical_tags);
+}
+
+MshFile::MemoryUsage::Amount
+usage(const MshFile::MultiDEntity & ent)
+{
+    auto amount = usage(ent.physical_tags);
+    amount += usage(ent.bounding_tags);
+    return amount;
+}
+
+} // namespace
+
+MshFile::MemoryUsage::Amount
+MshFile::MemoryUsage::total() const
+{
+    Amount amount;
+    for (auto & a : { this->nodes,
+                      this->node_tags,
+                      this->coordinates,
+                      this->par_coords,
+                      this->element_blocks,
+                      this->entities,
+                      this->names,
+                      this->spare_nodes,
+                      this->spare_element_blocks })
+        amount += a;
+    for (auto & blk : this->blocks) {
+        amount += blk.element_tags;
+        amount += blk.connectivity;
+    }
+    return amount;
+}
+
+MshFile::MshFile(std::pmr::memory_resource * resource) :
+    resource(data_resource(resource)),
+    read_ahead_block_size(0),
+    read_ahead_num_blocks(0),
+    num_threads(1),
+    coordinate_precision(Precision::DOUBLE),
+    read_par_coords(true),
+    collect_stats(false),
+    num_bulk_values(0),
+    payload_bytes_in_flight(0),
+    section_skipped(false),
+    input_size(0),
+    progress_interval(1 << 20),
+    next_progress(1 << 20),
+    cancelled(false),
+    in(nullptr),
+    lexer(&this->in),
     version(0.),
     binary(false),
-    endianness(0)
+    endianness(0),
+    physical_names(this->resource),
+    point_entities(this->resource),
+    curve_entities(this->resource),
+    surface_entities(this->resource),
+    volume_entities(this->resource),
+    nodes(this->resource),
+    element_blocks(this->resource),
+    spare_nodes(this->resource),
+    spare_element_blocks(this->resource)
+{
+}
+
+MshFile::MshFile(const std::string & file_name, std::pmr::memory_resource * resource) :
+    MshFile(resource)
+{
+    open(file_name);
+}
+
+MshFile::MshFile(std::istream & stream, std::pmr::memory_resource * resource) :
+    MshFile(resource)
+{
+    open(stream);
+}
+
+MshFile::MshFile(const char * data, std::size_t size, std::pmr::memory_resource * resource) :
+    MshFile(resource)
 {
+    open(data, size);
+}
+
+void
+MshFile::open(const std::string & file_name)
+{
+    reset();
+    this->file_name = file_name;
+    this->file.open(this->file_name, std::ios::binary);
     if (!this->file.is_open())
         throw Exception("Unable to open file '{}'.", this->file_name);
+    set_input(this->file.rdbuf());
+    if (!this->decompressor)
+        this->input_size = std::filesystem::file_size(this->file_name);
+}
+
+void
+MshFile::open(std::istream & stream)
+{
+    reset();
+    set_input(stream.rdbuf());
+}
+
+void
+MshFile::open(const char * data, std::size_t size)
+{
+    reset();
+    this->memory_buf = std::make_unique<MemoryStreamBuf>(data, size);
+    set_input(this->memory_buf.get());
+    if (!this->decompressor)
+        this->input_size = size;
+}
+
+void
+MshFile::reset()
+{
+    close();
+    // detaching the buffer sets badbit, which must not throw here
+    this->in.exceptions(std::ios::goodbit);
+    this->in.rdbuf(nullptr);
+    this->in.clear();
+    this->decompressor.reset();
+    this->memory_buf.reset();
+    this->file.clear();
+    this->file_name.clear();
+    this->lexer.reset();
+
+    this->stats = ParseStats();
+    this->num_bulk_values = 0;
+    this->section_skipped = false;
+    this->input_size = 0;
+    this->next_progress = this->progress_interval;
+    this->cancelled = false;
+    this->version = 0.;
+    this->binary = false;
+    this->endianness = 0;
+
+    // `clear` keeps the capacity, so that the next file can reuse the memory
+    this->physical_names.clear();
+    this->point_entities.clear();
+    this->curve_entities.clear();
+    this->surface_entities.clear();
+    this->volume_entities.clear();
+    // up to `MAX_SPARE_BLOCKS` blocks (with their buffers) are set aside for the section parsers
+    // of the next file; they go in reversed, so that they are handed out again in the same order
+    auto n_nodes = std::min(this->nodes.size(),
+                            MAX_SPARE_BLOCKS - std::min(MAX_SPARE_BLOCKS, this->spare_nodes.size()));
+    for (auto i = n_nodes; i-- > 0;) {
+        auto & node = this->nodes[i];
+        node.tags.clear();
+        node.coordinates.clear();
+        node.par_coords.clear();
+        node.float_coordinates.clear();
+        node.float_par_coords.clear();
+        this->spare_nodes.push_back(std::move(node));
+    }
+    clear_block_list(this->nodes, this->resource);
+    auto n_blocks = std::min(
+        this->element_blocks.size(),
+        MAX_SPARE_BLOCKS - std::min(MAX_SPARE_BLOCKS, this->spare_element_blocks.size()));
+    for (auto i = n_blocks; i-- > 0;) {
+        auto & blk = this->element_blocks[i];
+        blk.element_tags.clear();
+        blk.connectivity.clear();
+        this->spare_element_blocks.push_back(std::move(blk));
+    }
+    clear_block_list(this->element_blocks, this->resource);
+}
+
+void
+MshFile::release_spare()
+{
+    decltype(this->spare_nodes)(this->resource).swap(this->spare_nodes);
+    decltype(this->spare_element_blocks)(this->resource).swap(this->spare_element_blocks);
+}
+
+MshFile::Node &
+MshFile::add_node_block()
+{
+    if (this->spare_nodes.empty())
+        return this->nodes.emplace_back();
+    auto & node = this->nodes.emplace_back(std::move(this->spare_nodes.back()));
+    this->spare_nodes.pop_back();
+    node.dimension = -1;
+    node.entity_tag = -1;
+    node.parametric = false;
+    return node;
+}
+
+MshFile::ElementBlock &
+MshFile::add_element_block()
+{
+    if (this->spare_element_blocks.empty())
+        return this->element_blocks.emplace_back();
+    auto & blk = this->element_blocks.emplace_back(std::move(this->spare_element_blocks.back()));
+    this->spare_element_blocks.pop_back();
+    return blk;
+}
+
+void
+MshFile::set_input(std::streambuf * src)
+{
+    switch (detect_compression(src)) {
+    case Compression::GZIP:
+#ifdef GMSHPARSERCPP_WITH_ZLIB
+        this->decompressor = std::make_unique<GzipStreamBuf>(src);
+        break;
+#else
+        throw Exception("Input is gzip-compressed, but gmshparsercpp was built without zlib "
+                        "support.");
+#endif
+    case Compression::ZSTD:
+#ifdef GMSHPARSERCPP_WITH_ZSTD
+        this->decompressor = std::make_unique<ZstdStreamBuf>(src);
+        break;
+#else
+        throw Exception("Input is zstd-compressed, but gmshparsercpp was built without zstd "
+                        "support.");
+#endif
+    case Compression::NONE:
+        break;
+    }
+
+    if (this->decompressor)
+        this->in.rdbuf(this->decompressor.get());
+    else
+        this->in.rdbuf(src);
+    // let errors raised by the stream buffers (corrupted data, aborted input) reach the caller
+    this->in.exceptions(std::ios::badbit);
 }
 
 MshFile::~MshFile()
 {
     close();
+#ifdef GMSHPARSERCPP_COUNT_ALLOCATIONS
+    // containers still holding data keep the counting resource alive
+    release_counting_resource(this->resource);
+#endif
+}
+
+std::pmr::memory_resource *
+MshFile::get_memory_resource() const
+{
+    return this->resource;
 }
 
 double
@@ -35,61 +499,268 @@ MshFile::is_ascii() const
     return !this->binary;
 }
 
-const std::vector<MshFile::PhysicalName> &
+const std::pmr::vector<MshFile::PhysicalName> &
 MshFile::get_physical_names() const
 {
     return this->physical_names;
 }
 
-const std::vector<MshFile::PointEntity> &
+const std::pmr::vector<MshFile::PointEntity> &
 MshFile::get_point_entities() const
 {
     return this->point_entities;
 }
 
-const std::vector<MshFile::MultiDEntity> &
+const std::pmr::vector<MshFile::MultiDEntity> &
 MshFile::get_curve_entities() const
 {
     return this->curve_entities;
 }
 
-const std::vector<MshFile::MultiDEntity> &
+const std::pmr::vector<MshFile::MultiDEntity> &
 MshFile::get_surface_entities() const
 {
     return this->surface_entities;
 }
 
-const std::vector<MshFile::MultiDEntity> &
+const std::pmr::vector<MshFile::MultiDEntity> &
 MshFile::get_volume_entities() const
 {
     return this->volume_entities;
 }
 
-const std::vector<MshFile::Node> &
+const std::pmr::vector<MshFile::Node> &
 MshFile::get_nodes() const
 {
     return this->nodes;
 }
 
-const std::vector<MshFile::ElementBlock> &
+const std::pmr::vector<MshFile::ElementBlock> &
 MshFile::get_element_blocks() const
 {
     return this->element_blocks;
 }
 
+std::pmr::vector<MshFile::PhysicalName>
+MshFile::take_physical_names()
+{
+    return take(this->physical_names);
+}
+
+std::pmr::vector<MshFile::PointEntity>
+MshFile::take_point_entities()
+{
+    return take(this->point_entities);
+}
+
+std::pmr::vector<MshFile::MultiDEntity>
+MshFile::take_curve_entities()
+{
+    return take(this->curve_entities);
+}
+
+std::pmr::vector<MshFile::MultiDEntity>
+MshFile::take_surface_entities()
+{
+    return take(this->surface_entities);
+}
+
+std::pmr::vector<MshFile::MultiDEntity>
+MshFile::take_volume_entities()
+{
+    return take(this->volume_entities);
+}
+
+std::pmr::vector<MshFile::Node>
+MshFile::take_nodes()
+{
+    return take(this->nodes);
+}
+
+std::pmr::vector<MshFile::ElementBlock>
+MshFile::take_element_blocks()
+{
+    return take(this->element_blocks);
+}
+
+MshFile::Mesh
+MshFile::release()
+{
+    // members are move-constructed (not assigned), so they keep the memory resource of this file
+    return Mesh { take_physical_names(), take_point_entities(), take_curve_entities(),
+                  take_surface_entities(), take_volume_entities(), take_nodes(),
+                  take_element_blocks() };
+}
+
+void
+MshFile::set_read_ahead(std::size_t block_size, std::size_t num_blocks)
+{
+    this->read_ahead_block_size = block_size;
+    this->read_ahead_num_blocks = num_blocks;
+}
+
+void
+MshFile::set_num_threads(unsigned int n)
+{
+    this->num_threads = n;
+}
+
+void
+MshFile::set_coordinate_precision(Precision precision)
+{
+    this->coordinate_precision = precision;
+}
+
+void
+MshFile::set_read_par_coords(bool state)
+{
+    this->read_par_coords = state;
+}
+
+void
+MshFile::set_collect_stats(bool state)
+{
+    this->collect_stats = state;
+}
+
+const MshFile::ParseStats &
+MshFile::get_stats() const
+{
+    return this->stats;
+}
+
+void
+MshFile::set_progress_callback(ProgressCallback callback, std::size_t interval)
+{
+    this->progress_callback = std::move(callback);
+    this->progress_interval = std::max<std::size_t>(interval, 1);
+    this->next_progress = this->lexer.get_num_bytes() + this->progress_interval;
+}
+
+void
+MshFile::cancel()
+{
+    this->cancelled = true;
+}
+
+void
+MshFile::report_progress()
+{
+    auto num_bytes = this->lexer.get_num_bytes();
+    this->next_progress = num_bytes + this->progress_interval;
+    if (this->progress_callback && !this->progress_callback(num_bytes, this->input_size))
+        this->cancelled = true;
+    if (this->cancelled)
+        throw CancelledException();
+}
+
 void
 MshFile::parse()
 {
+    using clock = std::chrono::steady_clock;
+
+    if (this->read_ahead_block_size > 0 && !this->read_ahead) {
+        this->read_ahead = std::make_unique<ReadAheadStreamBuf>(this->in.rdbuf(),
+                                                                this->read_ahead_block_size,
+                                                                this->read_ahead_num_blocks);
+        this->in.rdbuf(this->read_ahead.get());
+    }
+
+    auto parse_start = clock::now();
+    auto parse_allocs = current_allocations();
     MshLexer::Token token = this->lexer.peek();
     do {
         if (token.type == MshLexer::Token::Section) {
             token = this->lexer.read();
-            process_section(token);
+            if (this->collect_stats) {
+                SectionStats sst;
+                sst.name = token.str;
+                auto num_bytes = this->lexer.get_num_bytes();
+                auto num_tokens = this->lexer.get_num_tokens();
+                auto num_values = this->lexer.get_num_values() + this->num_bulk_values;
+                auto allocs = current_allocations();
+                this->section_skipped = false;
+                auto start = clock::now();
+
+                process_section(token);
+
+                sst.time = std::chrono::duration<double>(clock::now() - start).count();
+                sst.skipped = this->section_skipped;
+                sst.num_bytes = this->lexer.get_num_bytes() - num_bytes;
+                sst.num_tokens = this->lexer.get_num_tokens() - num_tokens;
+                sst.num_values =
+                    this->lexer.get_num_values() + this->num_bulk_values - num_values;
+                auto allocs_end = current_allocations();
+                sst.num_allocations = allocs_end.count - allocs.count;
+                sst.allocated_bytes = allocs_end.bytes - allocs.bytes;
+                this->stats.sections.push_back(sst);
+            }
+            else
+                process_section(token);
         }
         else
             throw Exception("Expected start of section marker not found.");
+        // cancellation is checked after every section, progress only once per interval
+        if (this->cancelled)
+            throw CancelledException();
+        check_progress();
         token = this->lexer.peek();
     } while (token.type != MshLexer::Token::EndOfFile);
+    // the input is fully parsed, a cancellation arriving from now on (including one from the final
+    // report) does not throw away the complete result
+    if (this->progress_callback)
+        this->progress_callback(this->lexer.get_num_bytes(), this->input_size);
+
+    if (this->collect_stats) {
+        this->stats.time = std::chrono::duration<double>(clock::now() - parse_start).count();
+        this->stats.num_bytes = this->lexer.get_num_bytes();
+        auto allocs = current_allocations();
+        this->stats.num_allocations = allocs.count - parse_allocs.count;
+        this->stats.allocated_bytes = allocs.bytes - parse_allocs.bytes;
+    }
+}
+
+MshFile::MemoryUsage
+MshFile::memory_usage() const
+{
+    MemoryUsage mu;
+    mu.nodes = usage(this->nodes);
+    for (auto & node : this->nodes) {
+        mu.node_tags += usage(node.tags);
+        mu.coordinates += usage(node.coordinates);
+        mu.coordinates += usage(node.float_coordinates);
+        mu.par_coords += usage(node.par_coords);
+        mu.par_coords += usage(node.float_par_coords);
+    }
+
+    mu.element_blocks = usage(this->element_blocks);
+    mu.blocks.resize(this->element_blocks.size());
+    for (std::size_t i = 0; i < this->element_blocks.size(); i++) {
+        auto & blk = this->element_blocks[i];
+        mu.blocks[i].element_tags = usage(blk.element_tags);
+        mu.blocks[i].connectivity = usage(blk.connectivity);
+    }
+
+    mu.entities += usage(this->point_entities);
+    for (auto & ent : this->point_entities)
+        mu.entities += usage(ent);
+    for (auto * ents : { &this->curve_entities, &this->surface_entities, &this->volume_entities }) {
+        mu.entities += usage(*ents);
+        for (auto & ent : *ents)
+            mu.entities += usage(ent);
+    }
+
+    mu.names = usage(this->physical_names);
+    for (auto & pn : this->physical_names)
+        mu.names += usage(pn.name);
+
+    mu.spare_nodes = usage(this->spare_nodes);
+    for (auto & node : this->spare_nodes)
+        mu.spare_nodes += usage(node);
+    mu.spare_element_blocks = usage(this->spare_element_blocks);
+    for (auto & blk : this->spare_element_blocks)
+        mu.spare_element_blocks += usage(blk);
+    return mu;
 }
 
 void
@@ -163,9 +834,11 @@ MshFile::process_physical_names_section()
     for (int i = 0; i < num_entities; i++) {
         auto dimension = this->lexer.read().as<int>();
         auto tag = this->lexer.read().as<int>();
-        auto name = this->lexer.read().as<std::string>();
-        PhysicalName pn = { dimension, tag, name };
-        this->physical_names.push_back(pn);
+        auto & pn = this->physical_names.emplace_back();
+        pn.dimension = dimension;
+        pn.tag = tag;
+        // the name takes over the token string (and its allocation, counted by the lexer)
+        pn.name = std::move(this->lexer.read().str);
     }
 
     read_end_section_marker("$EndPhysicalNames");
@@ -180,17 +853,17 @@ MshFile::process_entities_section()
     auto num_volumes = this->lexer.get<size_t>();
 
     for (size_t i = 0; i < num_points; i++) {
-        PointEntity pe;
+        PointEntity pe(this->resource);
         pe.tag = this->lexer.get<int>();
         pe.x = this->lexer.get<double>();
         pe.y = this->lexer.get<double>();
         pe.z = this->lexer.get<double>();
-        pe.physical_tags = process_array_of_ints();
-        this->point_entities.push_back(pe);
+        process_array_of_ints(pe.physical_tags);
+        this->point_entities.push_back(std::move(pe));
     }
 
     for (size_t i = 0; i < num_curves; i++) {
-        MultiDEntity ent;
+        MultiDEntity ent(this->resource);
         ent.tag = this->lexer.get<int>();
         ent.min_x = this->lexer.get<double>();
         ent.min_y = this->lexer.get<double>();
@@ -198,13 +871,13 @@ MshFile::process_entities_section()
         ent.max_x = this->lexer.get<double>();
         ent.max_y = this->lexer.get<double>();
         ent.max_z = this->lexer.get<double>();
-        ent.physical_tags = process_array_of_ints();
-        ent.bounding_tags = process_array_of_ints();
-        this->curve_entities.push_back(ent);
+        process_array_of_ints(ent.physical_tags);
+        process_array_of_ints(ent.bounding_tags);
+        this->curve_entities.push_back(std::move(ent));
     }
 
     for (size_t i = 0; i < num_surfaces; i++) {
-        MultiDEntity ent;
+        MultiDEntity ent(this->resource);
         ent.tag = this->lexer.get<int>();
         ent.min_x = this->lexer.get<double>();
         ent.min_y = this->lexer.get<double>();
@@ -212,13 +885,13 @@ MshFile::process_entities_section()
         ent.max_x = this->lexer.get<double>();
         ent.max_y = this->lexer.get<double>();
         ent.max_z = this->lexer.get<double>();
-        ent.physical_tags = process_array_of_ints();
-        ent.bounding_tags = process_array_of_ints();
-        this->surface_entities.push_back(ent);
+        process_array_of_ints(ent.physical_tags);
+        process_array_of_ints(ent.bounding_tags);
+        this->surface_entities.push_back(std::move(ent));
     }
 
     for (size_t i = 0; i < num_volumes; i++) {
-        MultiDEntity ent;
+        MultiDEntity ent(this->resource);
         ent.tag = this->lexer.get<int>();
         ent.min_x = this->lexer.get<double>();
         ent.min_y = this->lexer.get<double>();
@@ -226,9 +899,9 @@ MshFile::process_entities_section()
         ent.max_x = this->lexer.get<double>();
         ent.max_y = this->lexer.get<double>();
         ent.max_z = this->lexer.get<double>();
-        ent.physical_tags = process_array_of_ints();
-        ent.bounding_tags = process_array_of_ints();
-        this->volume_entities.push_back(ent);
+        process_array_of_ints(ent.physical_tags);
+        process_array_of_ints(ent.bounding_tags);
+        this->volume_entities.push_back(std::move(ent));
     }
     read_end_section_marker("$EndEntities");
 }
@@ -249,17 +922,18 @@ MshFile::process_nodes_section_v2()
 {
     auto num_nodes = this->lexer.read().as<size_t>();
     for (std::size_t i = 0; i < num_nodes; i++) {
-        Node node;
+        auto & node = add_node_block();
         node.dimension = 0;
         node.entity_tag = this->lexer.get<int>();
 
-        Point pt;
-        pt.x = this->lexer.get<double>();
-        pt.y = this->lexer.get<double>();
-        pt.z = this->lexer.get<double>();
-        node.coordinates.push_back(pt);
+        double xyz[3];
+        this->lexer.get(xyz, 3);
+        if (this->coordinate_precision == Precision::SINGLE)
+            append_rows(node.float_coordinates, node.float_par_coords, false, xyz, 1, 0);
+        else
+            append_rows(node.coordinates, node.par_coords, false, xyz, 1, 0);
         node.tags.push_back(node.entity_tag);
-        this->nodes.push_back(node);
+        check_progress();
     }
 }
 
@@ -271,8 +945,15 @@ MshFile::process_nodes_section_v4()
     [[maybe_unused]] auto min_node_tag = this->lexer.get<size_t>();
     [[maybe_unused]] auto max_node_tag = this->lexer.get<size_t>();
 
+    if (this->binary && this->num_threads != 1) {
+        process_nodes_section_v4_parallel(num_entity_blocks);
+        return;
+    }
+
+    std::vector<double> row_buffer(NODE_ROWS_PER_BATCH * 6);
+    record_allocation(row_buffer.size() * sizeof(double));
     for (std::size_t i = 0; i < num_entity_blocks; i++) {
-        Node node;
+        auto & node = add_node_block();
         node.dimension = this->lexer.get<int>();
         node.entity_tag = this->lexer.get<int>();
         node.parametric = this->lexer.get<int>() == 1;
@@ -281,25 +962,97 @@ MshFile::process_nodes_section_v4()
             auto tag = this->lexer.get<size_t>();
             node.tags.push_back(tag);
         }
-        for (std::size_t i = 0; i < num_nodes_in_block; i++) {
-            Point pt;
-            pt.x = this->lexer.get<double>();
-            pt.y = this->lexer.get<double>();
-            pt.z = this->lexer.get<double>();
-            node.coordinates.push_back(pt);
-            if (node.parametric) {
-                Point par_pr;
-                if (node.dimension >= 1)
-                    par_pr.x = this->lexer.get<double>();
-                if (node.dimension >= 2)
-                    par_pr.y = this->lexer.get<double>();
-                if (node.dimension == 3)
-                    par_pr.z = this->lexer.get<double>();
-                node.par_coords.push_back(par_pr);
+        // rows of coordinates followed by the parametric coordinates are decoded in batches and
+        // converted to the stored precision right away
+        auto n_par = node.get_num_par_coords();
+        bool store_par = n_par > 0 && this->read_par_coords;
+        auto read_coordinates = [&](auto & coords, auto & par_coords) {
+            coords.reserve(num_nodes_in_block);
+            if (store_par)
+                par_coords.reserve(num_nodes_in_block * n_par);
+            for (std::size_t i = 0; i < num_nodes_in_block; i += NODE_ROWS_PER_BATCH) {
+                auto n_rows = std::min(NODE_ROWS_PER_BATCH, num_nodes_in_block - i);
+                this->lexer.get(row_buffer.data(), n_rows * (3 + n_par));
+                append_rows(coords, par_coords, store_par, row_buffer.data(), n_rows, n_par);
+                check_progress();
             }
+        };
+        if (this->coordinate_precision == Precision::SINGLE)
+            read_coordinates(node.float_coordinates, node.float_par_coords);
+        else
+            read_coordinates(node.coordinates, node.par_coords);
+    }
+}
+
+void
+MshFile::process_nodes_section_v4_parallel(std::size_t num_entity_blocks)
+{
+    ThreadPool pool(this->num_threads);
+    this->payload_bytes_in_flight = 0;
+    for (std::size_t i = 0; i < num_entity_blocks; i++) {
+        // blocks are created as their headers are read, so that a corrupt block count runs into the
+        // end of the input; queued tasks reference the blocks, so they finish before storage grows
+        if (this->nodes.size() == this->nodes.capacity())
+            wait_for_payloads(pool);
+        auto & node = add_node_block();
+        node.dimension = this->lexer.get<int>();
+        node.entity_tag = this->lexer.get<int>();
+        node.parametric = this->lexer.get<int>() == 1;
+        auto num_nodes_in_block = this->lexer.get<size_t>();
+        auto n_par = node.get_num_par_coords();
+        auto n_bytes =
+            payload_size(num_nodes_in_block, sizeof(std::size_t) + (3 + n_par) * sizeof(double));
+        auto data = read_payload(pool, n_bytes);
+        this->num_bulk_values += num_nodes_in_block * (4 + n_par);
+        // the memory resource need not be thread-safe, so all allocations happen on this thread
+        node.tags.resize(num_nodes_in_block);
+        auto submit = [&](auto & coords, auto & par_coords) {
+            coords.resize(num_nodes_in_block);
+            if (this->read_par_coords)
+                par_coords.resize(num_nodes_in_block * n_par);
+            pool.submit([&node, &coords, &par_coords, data, num_nodes_in_block]() {
+                decode_node_block(node, coords, par_coords, data->data(), num_nodes_in_block);
+            });
+        };
+        if (this->coordinate_precision == Precision::SINGLE)
+            submit(node.float_coordinates, node.float_par_coords);
+        else
+            submit(node.coordinates, node.par_coords);
+        check_progress();
+    }
+    pool.wait();
+}
+
+void
+MshFile::wait_for_payloads(ThreadPool & pool)
+{
+    pool.wait();
+    this->payload_bytes_in_flight = 0;
+}
+
+std::shared_ptr<std::vector<char>>
+MshFile::read_payload(ThreadPool & pool, std::size_t n_bytes)
+{
+    // bound the memory held by payloads waiting to be decoded
+    if (this->payload_bytes_in_flight + n_bytes > MAX_PAYLOAD_BYTES_IN_FLIGHT)
+        wait_for_payloads(pool);
+    this->payload_bytes_in_flight += n_bytes;
+
+    // the buffer grows with the data actually read, so a corrupt block size runs into the end of
+    // the input instead of allocating memory for data that does not exist
+    auto data = std::make_shared<std::vector<char>>();
+    record_allocation(sizeof(*data));
+    for (std::size_t n_read = 0; n_read < n_bytes;) {
+        auto n = std::min(PAYLOAD_CHUNK_SIZE, n_bytes - n_read);
+        if (data->capacity() < n_read + n) {
+            data->reserve(std::min(n_bytes, std::max(n_read + n, 2 * data->capacity())));
+            record_allocation(data->capacity());
         }
-        this->nodes.push_back(node);
+        data->resize(n_read + n);
+        this->lexer.read_bytes(data->data() + n_read, n);
+        n_read += n;
     }
+    return data;
 }
 
 void
@@ -318,46 +1071,46 @@ MshFile::process_elements_section_v2()
 {
     auto num_elements = this->lexer.read().as<size_t>();
     if (this->binary) {
-        for (std::size_t i = 0; i < num_elements; i++) {
+        // elements come in groups sharing one header; `num_elements` counts elements, not groups
+        for (std::size_t i = 0; i < num_elements;) {
             auto el_type = static_cast<ElementType>(this->lexer.get<int>());
             auto dim = get_element_dimension(el_type);
+            auto n_elem_nodes = get_nodes_per_element(el_type);
             auto n_els = this->lexer.get<int>();
+            if (n_els <= 0)
+                throw Exception("Unexpected number of elements found: {}", n_els);
             [[maybe_unused]] auto two = this->lexer.get<int>();
             for (auto k = 0; k < n_els; k++) {
-                Element el;
-
-                el.tag = this->lexer.get<int>();
+                auto tag = this->lexer.get<int>();
                 auto phys = this->lexer.get<int>();
                 [[maybe_unused]] auto ent = this->lexer.get<int>();
-                auto n_elem_nodes = get_nodes_per_element(el_type);
+                auto & blk = get_element_block_by_tag_create(dim, phys, el_type);
+                blk.element_tags.push_back(tag);
                 for (auto j = 0; j < n_elem_nodes; j++) {
                     auto nid = this->lexer.get<int>();
-                    el.node_tags.push_back(nid);
+                    blk.connectivity.push_back(nid);
                 }
-                auto & blk = get_element_block_by_tag_create(dim, phys);
-                blk.element_type = el_type;
-                blk.elements.push_back(el);
+                check_progress();
             }
+            i += n_els;
         }
     }
     else {
         for (std::size_t i = 0; i < num_elements; i++) {
-            Element el;
-            el.tag = this->lexer.get<int>();
+            auto tag = this->lexer.get<int>();
             auto el_type = static_cast<ElementType>(this->lexer.get<int>());
             [[maybe_unused]] auto two = this->lexer.get<int>();
             auto phys = this->lexer.get<int>();
             [[maybe_unused]] auto ent = this->lexer.get<int>();
             auto dim = get_element_dimension(el_type);
             auto n_elem_nodes = get_nodes_per_element(el_type);
+            auto & blk = get_element_block_by_tag_create(dim, phys, el_type);
+            blk.element_tags.push_back(tag);
             for (auto j = 0; j < n_elem_nodes; j++) {
                 auto nid = this->lexer.get<size_t>();
-                el.node_tags.push_back(nid);
+                blk.connectivity.push_back(nid);
             }
-
-            auto & blk = get_element_block_by_tag_create(dim, phys);
-            blk.element_type = el_type;
-            blk.elements.push_back(el);
+            check_progress();
         }
     }
 }
@@ -370,158 +1123,126 @@ MshFile::process_elements_section_v4()
     [[maybe_unused]] auto min_node_tag = this->lexer.get<size_t>();
     [[maybe_unused]] auto max_node_tag = this->lexer.get<size_t>();
 
+    if (this->binary && this->num_threads != 1) {
+        process_elements_section_v4_parallel(num_entity_blocks);
+        return;
+    }
+
     for (std::size_t i = 0; i < num_entity_blocks; i++) {
-        ElementBlock blk;
+        auto & blk = add_element_block();
         blk.dimension = this->lexer.get<int>();
         blk.tag = this->lexer.get<int>();
         blk.element_type = static_cast<ElementType>(this->lexer.get<int>());
         auto num_nodes_per_element = get_nodes_per_element(blk.element_type);
         auto num_elements_in_block = this->lexer.get<size_t>();
+        auto n_reserved = std::min(num_elements_in_block, MAX_RESERVED_ROWS);
+        blk.element_tags.reserve(n_reserved);
+        blk.connectivity.reserve(n_reserved * num_nodes_per_element);
+        // element tag followed by the node tags
+        std::vector<std::size_t> row(1 + num_nodes_per_element);
+        record_allocation(row.size() * sizeof(std::size_t));
         for (size_t j = 0; j < num_elements_in_block; j++) {
-            Element el;
-            el.tag = this->lexer.get<size_t>();
-            for (int k = 0; k < num_nodes_per_element; k++) {
-                auto tag = this->lexer.get<size_t>();
-                el.node_tags.push_back(tag);
-            }
-            blk.elements.push_back(el);
+            this->lexer.get(row.data(), row.size());
+            blk.element_tags.push_back(row[0]);
+            blk.connectivity.insert(blk.connectivity.end(), row.begin() + 1, row.end());
+            check_progress();
         }
-        this->element_blocks.push_back(blk);
     }
 }
 
-std::vector<int>
-MshFile::process_array_of_ints()
+void
+MshFile::process_elements_section_v4_parallel(std::size_t num_entity_blocks)
+{
+    ThreadPool pool(this->num_threads);
+    this->payload_bytes_in_flight = 0;
+    for (std::size_t i = 0; i < num_entity_blocks; i++) {
+        // see process_nodes_section_v4_parallel
+        if (this->element_blocks.size() == this->element_blocks.capacity())
+            wait_for_payloads(pool);
+        auto & blk = add_element_block();
+        blk.dimension = this->lexer.get<int>();
+        blk.tag = this->lexer.get<int>();
+        blk.element_type = static_cast<ElementType>(this->lexer.get<int>());
+        std::size_t num_nodes_per_element = get_nodes_per_element(blk.element_type);
+        auto num_elements_in_block = this->lexer.get<size_t>();
+        auto n_bytes =
+            payload_size(num_elements_in_block, (1 + num_nodes_per_element) * sizeof(std::size_t));
+        auto data = read_payload(pool, n_bytes);
+        this->num_bulk_values += num_elements_in_block * (1 + num_nodes_per_element);
+        // the memory resource need not be thread-safe, so all allocations happen on this thread
+        blk.element_tags.resize(num_elements_in_block);
+        blk.connectivity.resize(num_elements_in_block * num_nodes_per_element);
+        pool.submit([&blk, data, num_nodes_per_element]() {
+            decode_element_block(blk, data->data(), num_nodes_per_element);
+        });
+        check_progress();
+    }
+    pool.wait();
+}
+
+void
+MshFile::process_array_of_ints(std::pmr::vector<int> & array)
 {
-    std::vector<int> array;
     auto n = this->lexer.get<size_t>();
+    array.reserve(std::min(n, MAX_RESERVED_ROWS));
     for (size_t i = 0; i < n; i++) {
         auto num = this->lexer.get<int>();
         array.push_back(num);
     }
-    return array;
 }
 
 void
 MshFile::skip_section()
 {
+    this->section_skipped = true;
     MshLexer::Token token;
     do {
         token = this->lexer.read();
+        check_progress();
     } while (token.type != MshLexer::Token::Section);
 }
 
 int
 MshFile::get_nodes_per_element(ElementType element_type)
 {
-    // clang-format off
-    switch (element_type) {
-        case LINE2: return 2;
-        case TRI3: return 3;
-        case QUAD4: return 4;
-        case TET4: return 4;
-        case HEX8: return 8;
-        case PRISM6: return 6;
-        case PYRAMID5: return 5;
-        case LINE3: return 3;
-        case TRI6: return 6;
-        case QUAD9: return 9;
-        case TET10: return 10;
-        case HEX27: return 27;
-        case PRISM18: return 18;
-        case PYRAMID14: return 14;
-        case POINT: return 1;
-        case QUAD8: return 8;
-        case HEX20: return 20;
-        case PRISM15: return 15;
-        case PYRAMID13: return 13;
-        case ITRI9: return 9;
-        case TRI10: return 10;
-        case ITRI12: return 12;
-        case TRI15: return 15;
-        case ITRI15: return 15;
-        case TRI21: return 21;
-        case LINE4: return 4;
-        case LINE5: return 5;
-        case LINE6: return 6;
-        case TET20: return 20;
-        case TET35: return 35;
-        case TET56: return 56;
-        case HEX64: return 64;
-        case HEX125: return 125;
-        default:
-            throw Exception("Unknown element type '{}'", element_type);
-    }
-    // clang-format on
+    auto & info = element_info(element_type);
+    if (!info.is_valid())
+        throw Exception("Unknown element type '{}'", element_type);
+    return info.num_nodes;
 }
 
 int
 MshFile::get_element_dimension(ElementType element_type)
 {
-    switch (element_type) {
-    case POINT:
-        return 0;
-
-    case LINE2:
-    case LINE3:
-    case LINE4:
-    case LINE5:
-    case LINE6:
-        return 1;
-
-    case TRI3:
-    case QUAD4:
-    case TRI6:
-    case QUAD9:
-    case QUAD8:
-    case ITRI9:
-    case TRI10:
-    case ITRI12:
-    case TRI15:
-    case ITRI15:
-    case TRI21:
-        return 2;
-
-    case TET4:
-    case HEX8:
-    case PRISM6:
-    case PYRAMID5:
-    case TET10:
-    case HEX27:
-    case PRISM18:
-    case PYRAMID14:
-    case HEX20:
-    case PRISM15:
-    case PYRAMID13:
-    case TET20:
-    case TET35:
-    case TET56:
-    case HEX64:
-    case HEX125:
-        return 3;
-
-    default:
+    auto & info = element_info(element_type);
+    if (!info.is_valid())
         throw Exception("Unknown element type '{}'", element_type);
-    }
+    return info.dimension;
 }
 
 MshFile::ElementBlock &
-MshFile::get_element_block_by_tag_create(int dim, int tag)
+MshFile::get_element_block_by_tag_create(int dim, int tag, ElementType type)
 {
+    // blocks hold a single element type, so that their connectivity has a fixed stride
     for (auto & eblk : this->element_blocks) {
-        if ((eblk.tag == tag) && (eblk.dimension == dim))
+        if ((eblk.tag == tag) && (eblk.dimension == dim) && (eblk.element_type == type))
             return eblk;
     }
-    ElementBlock blk;
+    auto & blk = add_element_block();
     blk.tag = tag;
     blk.dimension = dim;
-    this->element_blocks.push_back(blk);
-    return this->element_blocks.back();
+    blk.element_type = type;
+    return blk;
 }
 
 void
 MshFile::close()
 {
+    if (this->read_ahead) {
+        // stop the background reader before the file goes away
+        this->in.rdbuf(this->read_ahead->get_source());
+        this->read_ahead.reset();
+    }
     if (this->file.is_open())
         this->file.close();
 }
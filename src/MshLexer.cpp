@@ -2,11 +2,98 @@
 // SPDX-License-Identifier: MIT
 
 #include "gmshparsercpp/MshLexer.h"
-#include <iostream>
+#include "TokenScanner.h"
+#ifdef GMSHPARSERCPP_COUNT_ALLOCATIONS
+    #include "AllocationCounter.h"
+#endif
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
 
 namespace gmshparsercpp {
 
-MshLexer::MshLexer(std::ifstream * in) : in(in), have_token(false), binary(false) {}
+namespace {
+
+/// Initial size of the input buffer
+constexpr std::size_t BUFFER_SIZE = 64 * 1024;
+/// Maximum number of tokens located by one call to the scanner
+constexpr std::size_t MAX_BATCH = 1024;
+
+/// Record a heap allocation (no-op when allocations are not counted)
+///
+/// @param what Number of bytes or a string whose heap buffer is recorded
+template <typename T>
+inline void
+record_allocation([[maybe_unused]] const T & what)
+{
+#ifdef GMSHPARSERCPP_COUNT_ALLOCATIONS
+    count_allocation(what);
+#endif
+}
+
+const char *
+find_non_letter(const char * p, const char * end)
+{
+    for (; p < end; p++)
+        if (!((*p >= 'A' && *p <= 'Z') || (*p >= 'a' && *p <= 'z')))
+            break;
+    return p;
+}
+
+const char *
+find_quote(const char * p, const char * end)
+{
+    auto q = static_cast<const char *>(std::memchr(p, '"', end - p));
+    return q ? q : end;
+}
+
+/// Decode a number token
+///
+/// @return `false` if `[begin, end)` is not entirely a number (the caller then falls back to the
+///         conversions used by `Token::as`, so both paths accept the same input)
+template <typename T>
+bool
+decode(const char * begin, const char * end, T & value)
+{
+    auto res = std::from_chars(begin, end, value);
+    return res.ec == std::errc() && res.ptr == end;
+}
+
+template <>
+bool
+decode(const char * begin, const char * end, double & value)
+{
+#if defined(__cpp_lib_to_chars)
+    // floating point `from_chars` uses Eisel-Lemire in the common case; anything it rejects
+    // (leading `+`, hex floats, out-of-range values) is left for `strtod` in `Token::as`
+    auto res = std::from_chars(begin, end, value);
+    return res.ec == std::errc() && res.ptr == end;
+#else
+    // the token is followed by white space in the buffer, so `strtod` stops at `end`
+    char * last;
+    value = std::strtod(begin, &last);
+    return last == end;
+#endif
+}
+
+} // namespace
+
+MshLexer::MshLexer(std::istream * in) :
+    in(in),
+    scanner(&token_scanner()),
+    buffer(BUFFER_SIZE),
+    pos(0),
+    end(0),
+    eof(false),
+    token_starts(MAX_BATCH),
+    token_ends(MAX_BATCH),
+    have_token(false),
+    binary(false),
+    num_bytes(0),
+    num_tokens(0),
+    num_values(0)
+{
+}
 
 void
 MshLexer::set_binary(bool state)
@@ -14,105 +101,189 @@ MshLexer::set_binary(bool state)
     this->binary = state;
 }
 
+void
+MshLexer::reset()
+{
+    this->pos = 0;
+    this->end = 0;
+    this->eof = false;
+    this->have_token = false;
+    this->binary = false;
+    this->num_bytes = 0;
+    this->num_tokens = 0;
+    this->num_values = 0;
+}
+
+bool
+MshLexer::fill()
+{
+    if (this->eof)
+        return false;
+    if (this->pos > 0) {
+        std::memmove(this->buffer.data(), this->buffer.data() + this->pos, this->end - this->pos);
+        this->end -= this->pos;
+        this->pos = 0;
+    }
+    if (this->end == this->buffer.size()) {
+        this->buffer.resize(2 * this->buffer.size());
+        record_allocation(this->buffer.size());
+    }
+    std::size_t size = this->buffer.size() - this->end;
+    this->in->read(this->buffer.data() + this->end, size);
+    std::size_t n = this->in->gcount();
+    this->end += n;
+    if (n < size)
+        this->eof = true;
+    return n > 0;
+}
+
+void
+MshLexer::read_bytes_slow(char * data, std::size_t size)
+{
+    while (true) {
+        std::size_t n = std::min(size, this->end - this->pos);
+        std::memcpy(data, this->buffer.data() + this->pos, n);
+        consume(n);
+        data += n;
+        size -= n;
+        if (size == 0)
+            return;
+        if (size >= this->buffer.size()) {
+            // large blobs go straight from the stream into `data`
+            if (!this->eof)
+                this->in->read(data, size);
+            std::size_t n_read = this->eof ? 0 : this->in->gcount();
+            this->num_bytes += n_read;
+            if (n_read != size) {
+                this->eof = true;
+                throw Exception("Reached end of file");
+            }
+            return;
+        }
+        if (!fill())
+            throw Exception("Reached end of file");
+    }
+}
+
 MshLexer::Token
 MshLexer::read()
 {
-    peek();
+    fetch();
     this->have_token = false;
-    return this->curr;
+    // the cached token is not needed anymore, so its string is handed over without a copy
+    return std::move(this->curr);
 }
 
 MshLexer::Token
 MshLexer::peek()
+{
+    fetch();
+    Token token = this->curr;
+    record_allocation(token.str);
+    return token;
+}
+
+void
+MshLexer::fetch()
 {
     if (!this->have_token) {
         this->curr = read_token();
         this->have_token = true;
+        this->num_tokens++;
     }
-    return this->curr;
 }
 
 MshLexer::Token
 MshLexer::read_token()
 {
+    // skip white spaces
     while (true) {
-        if (this->in->peek() == EOF) {
+        auto begin = this->buffer.data() + this->pos;
+        auto p = this->scanner->skip_whitespace(begin, this->buffer.data() + this->end);
+        consume(p - begin);
+        if (this->pos < this->end)
+            break;
+        if (!fill()) {
             Token t = { Token::EndOfFile, "", -1 };
             return t;
         }
+    }
 
-        std::string str_tok;
-        char ch = read_char();
-        if (ch == '$') {
-            // $SectionName
-            str_tok += ch;
-            while (true) {
-                auto next = peek_char();
-                if ((next >= 'A' && next <= 'Z') || (next >= 'a' && next <= 'z')) {
-                    str_tok += read_char();
-                }
-                else {
-                    // read the delimiting char
-                    read_char();
-                    Token token = { Token::Section, str_tok, -1 };
-                    return token;
-                }
-            }
-        }
-        else if (ch == '"') {
-            // "string"
-            while (true) {
-                auto next = peek_char();
-                if (next == '"') {
-                    read_char();
-                    break;
-                }
-                else
-                    str_tok += read_char();
-            }
+    Token::EType type;
+    std::size_t first;
+    const char * (*find_end)(const char *, const char *);
+    char ch = this->buffer[this->pos];
+    if (ch == '$') {
+        // $SectionName
+        type = Token::Section;
+        first = 0;
+        find_end = &find_non_letter;
+    }
+    else if (ch == '"') {
+        // "string"
+        type = Token::String;
+        first = 1;
+        find_end = &find_quote;
+    }
+    else {
+        // numbers
+        type = Token::Number;
+        first = 0;
+        find_end = this->scanner->find_whitespace;
+    }
 
-            Token token = { Token::String, str_tok, -1 };
-            return token;
-        }
-        else if (ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n') {
-            // skip white spaces
-            continue;
-        }
-        else {
-            // numbers
-            str_tok += ch;
-            while (true) {
-                auto next = peek_char();
-                if (next == ' ' || next == '\t' || next == '\n' || next == '\r') {
-                    // read the delimiting char
-                    read_char();
-                    Token token = { Token::Number, str_tok, -1 };
-                    return token;
-                }
-                else
-                    str_tok += read_char();
-            }
-        }
+    // offset of the delimiting char from `pos`, stays valid when the buffer is refilled
+    std::size_t last = 1;
+    while (true) {
+        auto begin = this->buffer.data() + this->pos;
+        auto end = this->buffer.data() + this->end;
+        auto p = find_end(begin + last, end);
+        last = p - begin;
+        if (p != end)
+            break;
+        if (!fill())
+            throw Exception("Reached end of file");
     }
-}
 
-char
-MshLexer::read_char()
-{
-    char ch;
-    this->in->read(&ch, sizeof(ch));
-    if (ch == EOF)
-        throw Exception("Reached end of file");
-    return ch;
+    Token token = { type, std::string(this->buffer.data() + this->pos + first, last - first), -1 };
+    record_allocation(token.str);
+    // read the delimiting char
+    consume(last + 1);
+    return token;
 }
 
-int
-MshLexer::peek_char()
+template <typename T>
+void
+MshLexer::read_ascii(T * values, std::size_t n)
 {
-    auto ch = this->in->peek();
-    if (ch == EOF)
-        throw Exception("Reached end of file");
-    return ch;
+    std::size_t i = 0;
+    if (i < n && this->have_token)
+        values[i++] = read().template as<T>();
+    while (i < n) {
+        auto begin = this->buffer.data() + this->pos;
+        auto n_tokens = this->scanner->scan_tokens(begin,
+                                                   this->buffer.data() + this->end,
+                                                   this->token_starts.data(),
+                                                   this->token_ends.data(),
+                                                   std::min(n - i, MAX_BATCH));
+        std::size_t k = 0;
+        for (; k < n_tokens; k++)
+            if (!decode(begin + this->token_starts[k], begin + this->token_ends[k], values[i + k]))
+                break;
+        if (k > 0) {
+            consume(this->token_ends[k - 1] + 1);
+            this->num_tokens += k;
+            i += k;
+        }
+        // no complete token in the buffer or a token that is not a plain number: take the
+        // general path, which refills the buffer and reports errors
+        if (k < n_tokens || n_tokens == 0)
+            values[i++] = read().template as<T>();
+    }
 }
 
+template void MshLexer::read_ascii(int *, std::size_t);
+template void MshLexer::read_ascii(std::size_t *, std::size_t);
+template void MshLexer::read_ascii(double *, std::size_t);
+
 } // namespace gmshparsercpp
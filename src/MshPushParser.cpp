@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "gmshparsercpp/MshPushParser.h"
+#include "PipeStreamBuf.h"
+
+namespace gmshparsercpp {
+
+MshPushParser::MshPushParser(std::size_t capacity, std::pmr::memory_resource * resource) :
+    pipe(std::make_unique<PipeStreamBuf>(capacity)),
+    stream(this->pipe.get()),
+    file(std::make_unique<MshFile>(resource)),
+    started(false),
+    finished(false),
+    done(false)
+{
+}
+
+MshPushParser::~MshPushParser()
+{
+    if (this->thread.joinable()) {
+        this->pipe->abort();
+        this->thread.join();
+    }
+}
+
+void
+MshPushParser::set_setup_callback(SetupCallback setup)
+{
+    if (this->started)
+        throw Exception("Cannot set up the parser after data was fed.");
+    this->setup = std::move(setup);
+}
+
+void
+MshPushParser::start()
+{
+    if (this->started)
+        return;
+    this->started = true;
+    this->thread = std::thread([this]() {
+        try {
+            if (this->setup)
+                this->setup(*this->file);
+            // opening the stream looks at the input, so it has to happen here and not on the
+            // feeding thread
+            this->file->open(this->stream);
+            this->file->parse();
+        }
+        catch (...) {
+            this->error = std::current_exception();
+            this->pipe->abort();
+        }
+    });
+}
+
+void
+MshPushParser::feed(const char * data, std::size_t size)
+{
+    if (this->finished)
+        throw Exception("Cannot feed data after the input was finished.");
+    start();
+    if (!this->pipe->write(data, size))
+        join();
+}
+
+std::size_t
+MshPushParser::try_feed(const char * data, std::size_t size)
+{
+    if (this->finished)
+        throw Exception("Cannot feed data after the input was finished.");
+    start();
+    std::size_t n_written;
+    if (!this->pipe->try_write(data, size, n_written))
+        join();
+    return n_written;
+}
+
+void
+MshPushParser::finish()
+{
+    if (this->finished)
+        return;
+    this->finished = true;
+    start();
+    this->pipe->close();
+    join();
+    this->done = true;
+}
+
+const MshFile &
+MshPushParser::get_file() const
+{
+    if (!this->done)
+        throw Exception("Parsing is not finished.");
+    return *this->file;
+}
+
+MshFile::Mesh
+MshPushParser::release()
+{
+    if (!this->done)
+        throw Exception("Parsing is not finished.");
+    return this->file->release();
+}
+
+void
+MshPushParser::join()
+{
+    if (this->thread.joinable())
+        this->thread.join();
+    if (this->error)
+        std::rethrow_exception(this->error);
+}
+
+} // namespace gmshparsercpp
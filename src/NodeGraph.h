@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "gmshparsercpp/Topology.h"
+
+namespace gmshparsercpp {
+
+class ThreadPool;
+
+/// Build the node graph on an existing thread pool
+///
+/// Same as `build_node_graph`, for callers that already run a thread pool.
+///
+/// @param nodes Node numbering
+/// @param elements Elements connecting the nodes
+/// @param pool Thread pool to run on
+/// @return Node graph, throws if the elements reference an unknown node tag
+Csr make_node_graph(const NodeNumbering & nodes,
+                    const ElementNumbering & elements,
+                    ThreadPool & pool);
+
+} // namespace gmshparsercpp
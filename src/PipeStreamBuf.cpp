@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "PipeStreamBuf.h"
+#include "gmshparsercpp/Exception.h"
+#include <algorithm>
+
+namespace gmshparsercpp {
+
+PipeStreamBuf::PipeStreamBuf(std::size_t capacity) :
+    capacity(std::max<std::size_t>(capacity, 1)),
+    queued(0),
+    closed(false),
+    aborted(false)
+{
+}
+
+bool
+PipeStreamBuf::write(const char * data, std::size_t size)
+{
+    while (size > 0) {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->cv.wait(lock, [&] { return this->aborted || this->queued < this->capacity; });
+        if (this->aborted)
+            return false;
+        if (this->closed)
+            throw Exception("Cannot write into a closed pipe.");
+
+        auto n = append(data, size);
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+bool
+PipeStreamBuf::try_write(const char * data, std::size_t size, std::size_t & n_written)
+{
+    n_written = 0;
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->aborted)
+        return false;
+    if (this->closed)
+        throw Exception("Cannot write into a closed pipe.");
+    n_written = append(data, size);
+    return true;
+}
+
+std::size_t
+PipeStreamBuf::append(const char * data, std::size_t size)
+{
+    // data that does not fit is split, so that at most `capacity` bytes are ever queued
+    auto n = std::min(size, this->capacity - this->queued);
+    if (n > 0) {
+        this->chunks.emplace_back(data, data + n);
+        this->queued += n;
+        this->cv.notify_all();
+    }
+    return n;
+}
+
+void
+PipeStreamBuf::close()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->closed = true;
+    this->cv.notify_all();
+}
+
+void
+PipeStreamBuf::abort()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->aborted = true;
+    this->chunks.clear();
+    this->queued = 0;
+    this->cv.notify_all();
+}
+
+PipeStreamBuf::int_type
+PipeStreamBuf::underflow()
+{
+    if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->cv.wait(lock, [&] { return this->aborted || this->closed || !this->chunks.empty(); });
+    if (this->aborted)
+        throw Exception("Parsing aborted.");
+    if (this->chunks.empty())
+        return traits_type::eof();
+
+    this->current = std::move(this->chunks.front());
+    this->chunks.pop_front();
+    this->queued -= this->current.size();
+    this->cv.notify_all();
+
+    setg(this->current.data(), this->current.data(), this->current.data() + this->current.size());
+    return traits_type::to_int_type(*gptr());
+}
+
+} // namespace gmshparsercpp
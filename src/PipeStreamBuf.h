@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <streambuf>
+#include <vector>
+
+namespace gmshparsercpp {
+
+/// Stream buffer connecting a producer that pushes chunks of data with a consumer reading them
+/// as a regular stream
+///
+/// The amount of queued data is bounded; the producer blocks when the limit is reached until the
+/// consumer catches up, or uses `try_write` to queue only what fits.
+class PipeStreamBuf : public std::streambuf {
+public:
+    /// Construct pipe stream buffer
+    ///
+    /// @param capacity Maximum number of bytes queued before `write` blocks
+    explicit PipeStreamBuf(std::size_t capacity);
+
+    /// Append data to the pipe (producer side)
+    ///
+    /// @param data Pointer to the data
+    /// @param size Number of bytes
+    /// @return `false` if the consumer stopped reading and the data was dropped
+    bool write(const char * data, std::size_t size);
+
+    /// Append as much data as fits without blocking (producer side)
+    ///
+    /// @param data Pointer to the data
+    /// @param size Number of bytes
+    /// @param n_written Number of bytes appended, 0 if the pipe is full
+    /// @return `false` if the consumer stopped reading and the data was dropped
+    bool try_write(const char * data, std::size_t size, std::size_t & n_written);
+
+    /// Signal that no more data will be written (producer side)
+    void close();
+
+    /// Stop reading; pending and future writes are dropped (consumer side)
+    void abort();
+
+protected:
+    int_type underflow() override;
+
+private:
+    /// Queue as much data as fits, with `mutex` held
+    ///
+    /// @return Number of bytes queued
+    std::size_t append(const char * data, std::size_t size);
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    /// Chunks waiting to be consumed
+    std::deque<std::vector<char>> chunks;
+    /// Chunk currently exposed as the get area
+    std::vector<char> current;
+    /// Maximum number of queued bytes
+    std::size_t capacity;
+    /// Number of queued bytes
+    std::size_t queued;
+    /// Flag indicating that the producer is done
+    bool closed;
+    /// Flag indicating that the consumer is done
+    bool aborted;
+};
+
+} // namespace gmshparsercpp
@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ReadAheadStreamBuf.h"
+#include <algorithm>
+#include <new>
+
+namespace gmshparsercpp {
+
+namespace {
+
+constexpr std::size_t PAGE_SIZE = 4096;
+
+} // namespace
+
+ReadAheadStreamBuf::ReadAheadStreamBuf(std::streambuf * src,
+                                       std::size_t block_size,
+                                       std::size_t num_blocks) :
+    src(src),
+    block_size(std::max<std::size_t>(block_size, 1)),
+    blocks(std::max<std::size_t>(num_blocks, 1)),
+    current(-1),
+    next(0),
+    src_eof(false),
+    stop(false)
+{
+    for (auto & blk : this->blocks) {
+        blk.data = static_cast<char *>(
+            ::operator new(this->block_size, std::align_val_t(PAGE_SIZE)));
+        blk.size = 0;
+        blk.filled = false;
+    }
+    setg(nullptr, nullptr, nullptr);
+    this->thread = std::thread(&ReadAheadStreamBuf::fill, this);
+}
+
+ReadAheadStreamBuf::~ReadAheadStreamBuf()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stop = true;
+    }
+    this->cv.notify_all();
+    this->thread.join();
+    for (auto & blk : this->blocks)
+        ::operator delete(blk.data, std::align_val_t(PAGE_SIZE));
+}
+
+std::streambuf *
+ReadAheadStreamBuf::get_source() const
+{
+    return this->src;
+}
+
+void
+ReadAheadStreamBuf::fill()
+{
+    std::size_t idx = 0;
+    while (true) {
+        auto & blk = this->blocks[idx];
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->cv.wait(lock, [&] { return this->stop || !blk.filled; });
+            if (this->stop)
+                return;
+        }
+
+        // the block is not visible to the consumer, so it can be filled without holding the lock
+        std::size_t n = 0;
+        std::exception_ptr err;
+        try {
+            while (n < this->block_size) {
+                auto k = this->src->sgetn(blk.data + n, this->block_size - n);
+                if (k <= 0)
+                    break;
+                n += k;
+            }
+        }
+        catch (...) {
+            err = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            blk.size = n;
+            blk.filled = n > 0;
+            if (err)
+                this->error = err;
+            if (err || n < this->block_size)
+                this->src_eof = true;
+        }
+        this->cv.notify_all();
+        if (this->src_eof)
+            return;
+        idx = (idx + 1) % this->blocks.size();
+    }
+}
+
+ReadAheadStreamBuf::int_type
+ReadAheadStreamBuf::underflow()
+{
+    if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    // hand the consumed block back to the background thread
+    if (this->current >= 0) {
+        this->blocks[this->current].filled = false;
+        this->current = -1;
+        setg(nullptr, nullptr, nullptr);
+        this->cv.notify_all();
+    }
+
+    auto & blk = this->blocks[this->next];
+    this->cv.wait(lock, [&] { return blk.filled || this->src_eof; });
+    if (!blk.filled) {
+        if (this->error)
+            std::rethrow_exception(this->error);
+        return traits_type::eof();
+    }
+
+    this->current = static_cast<int>(this->next);
+    this->next = (this->next + 1) % this->blocks.size();
+    setg(blk.data, blk.data, blk.data + blk.size);
+    return traits_type::to_int_type(*gptr());
+}
+
+} // namespace gmshparsercpp
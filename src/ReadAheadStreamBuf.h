@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+namespace gmshparsercpp {
+
+/// Stream buffer that reads from another stream buffer ahead of the consumer
+///
+/// A background thread fills a ring of page-aligned blocks from the source, while the consumer
+/// decodes data from the blocks that are already filled. With two or more blocks, I/O (and
+/// decompression, if the source is a decompressor) overlaps with decoding.
+class ReadAheadStreamBuf : public std::streambuf {
+public:
+    /// Construct read-ahead stream buffer
+    ///
+    /// @param src Source stream buffer; it is read only from the background thread from now on
+    /// @param block_size Size of one block in bytes
+    /// @param num_blocks Number of blocks in the ring
+    ReadAheadStreamBuf(std::streambuf * src, std::size_t block_size, std::size_t num_blocks);
+    ~ReadAheadStreamBuf() override;
+
+    /// Get the source stream buffer
+    std::streambuf * get_source() const;
+
+protected:
+    int_type underflow() override;
+
+private:
+    struct Block {
+        /// Block data
+        char * data;
+        /// Number of valid bytes
+        std::size_t size;
+        /// Flag indicating that the block holds data not yet consumed
+        bool filled;
+    };
+
+    /// Body of the background thread
+    void fill();
+
+    /// Source of the data
+    std::streambuf * src;
+    /// Size of one block in bytes
+    std::size_t block_size;
+    /// Ring of blocks
+    std::vector<Block> blocks;
+    /// Index of the block exposed as the get area (`-1` if none)
+    int current;
+    /// Index of the next block to be consumed
+    std::size_t next;
+    std::mutex mutex;
+    std::condition_variable cv;
+    /// Flag indicating that the source has no more data
+    bool src_eof;
+    /// Flag asking the background thread to stop
+    bool stop;
+    /// Error raised while reading the source
+    std::exception_ptr error;
+    /// Background thread
+    std::thread thread;
+};
+
+} // namespace gmshparsercpp
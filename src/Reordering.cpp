@@ -0,0 +1,548 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "gmshparsercpp/Reordering.h"
+#include "gmshparsercpp/ElementTraits.h"
+#include "gmshparsercpp/Exception.h"
+#include "gmshparsercpp/Topology.h"
+#include "NodeGraph.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <numeric>
+
+namespace gmshparsercpp {
+
+namespace {
+
+/// Number of bits per coordinate in space-filling curve keys
+constexpr int SFC_BITS = 21;
+/// Largest quantized coordinate
+constexpr std::uint32_t SFC_MAX = (1u << SFC_BITS) - 1;
+
+/// Get coordinates of a node in double precision
+MshFile::Point
+node_point(const MshFile::Node & node, std::size_t i)
+{
+    if (!node.float_coordinates.empty()) {
+        auto & p = node.float_coordinates[i];
+        return { p.x, p.y, p.z };
+    }
+    return node.coordinates[i];
+}
+
+/// Maps points into the integer grid space-filling curves run through
+struct Quantizer {
+    std::array<double, 3> lo;
+    double scale;
+
+    std::array<std::uint32_t, 3>
+    operator()(const MshFile::Point & pt) const
+    {
+        std::array<double, 3> x = { pt.x, pt.y, pt.z };
+        std::array<std::uint32_t, 3> q;
+        for (int d = 0; d < 3; d++) {
+            auto v = (x[d] - this->lo[d]) * this->scale;
+            q[d] = v <= 0. ? 0 : static_cast<std::uint32_t>(std::min<double>(v, SFC_MAX));
+        }
+        return q;
+    }
+};
+
+/// Spread the lower `SFC_BITS` bits of `v`, so that bit `j` moves to bit `3 j`
+std::uint64_t
+spread_bits(std::uint32_t v)
+{
+    std::uint64_t x = v & SFC_MAX;
+    x = (x | x << 32) & 0x1f00000000ffffULL;
+    x = (x | x << 16) & 0x1f0000ff0000ffULL;
+    x = (x | x << 8) & 0x100f00f00f00f00fULL;
+    x = (x | x << 4) & 0x10c30c30c30c30c3ULL;
+    x = (x | x << 2) & 0x1249249249249249ULL;
+    return x;
+}
+
+/// Position of a grid point along the Morton curve
+std::uint64_t
+morton_key(const std::array<std::uint32_t, 3> & q)
+{
+    return spread_bits(q[0]) | spread_bits(q[1]) << 1 | spread_bits(q[2]) << 2;
+}
+
+/// Position of a grid point along the Hilbert curve
+///
+/// Coordinates are transformed into the "transposed" Hilbert index (J. Skilling, Programming the
+/// Hilbert curve, AIP Conf. Proc. 707, 2004), whose bits are then interleaved.
+std::uint64_t
+hilbert_key(std::array<std::uint32_t, 3> x)
+{
+    constexpr std::uint32_t M = 1u << (SFC_BITS - 1);
+    for (std::uint32_t q = M; q > 1; q >>= 1) {
+        std::uint32_t p = q - 1;
+        for (int i = 0; i < 3; i++) {
+            if (x[i] & q)
+                x[0] ^= p;
+            else {
+                std::uint32_t t = (x[0] ^ x[i]) & p;
+                x[0] ^= t;
+                x[i] ^= t;
+            }
+        }
+    }
+    x[1] ^= x[0];
+    x[2] ^= x[1];
+    std::uint32_t t = 0;
+    for (std::uint32_t q = M; q > 1; q >>= 1)
+        if (x[2] & q)
+            t ^= q - 1;
+    for (auto & v : x)
+        v ^= t;
+    return spread_bits(x[0]) << 2 | spread_bits(x[1]) << 1 | spread_bits(x[2]);
+}
+
+/// Get the position of the first node of each node block, plus the total
+std::vector<std::size_t>
+node_block_offsets(const std::pmr::vector<MshFile::Node> & nodes)
+{
+    std::vector<std::size_t> offsets(nodes.size() + 1);
+    offsets[0] = 0;
+    for (std::size_t b = 0; b < nodes.size(); b++)
+        offsets[b + 1] = offsets[b] + nodes[b].tags.size();
+    return offsets;
+}
+
+/// Call `body(n, blk, i)` for nodes `[begin, end)`, where `n` is node `i` of block `blk`
+template <typename BODY>
+void
+for_each_node(const std::pmr::vector<MshFile::Node> & nodes,
+              const std::vector<std::size_t> & offsets,
+              std::size_t begin,
+              std::size_t end,
+              BODY body)
+{
+    if (begin >= end)
+        return;
+    std::size_t b = std::upper_bound(offsets.begin(), offsets.end(), begin) - offsets.begin() - 1;
+    for (auto n = begin; n < end; n++) {
+        while (n >= offsets[b + 1])
+            b++;
+        body(n, nodes[b], n - offsets[b]);
+    }
+}
+
+/// Get coordinates of all nodes (in double precision), in the order of the node blocks
+std::vector<MshFile::Point>
+dense_points(const std::pmr::vector<MshFile::Node> & nodes,
+             const std::vector<std::size_t> & offsets,
+             ThreadPool & pool)
+{
+    std::vector<MshFile::Point> points(offsets.back());
+    pool.parallel_for(points.size(), [&](std::size_t begin, std::size_t end) {
+        for_each_node(nodes,
+                      offsets,
+                      begin,
+                      end,
+                      [&](std::size_t n, const MshFile::Node & blk, std::size_t i) {
+                          points[n] = node_point(blk, i);
+                      });
+    });
+    return points;
+}
+
+/// Set up a quantizer mapping the bounding box of `points` into the integer grid
+Quantizer
+make_quantizer(const std::vector<MshFile::Point> & points, ThreadPool & pool)
+{
+    constexpr double INF = std::numeric_limits<double>::max();
+    std::array<double, 3> lo = { INF, INF, INF };
+    std::array<double, 3> hi = { -INF, -INF, -INF };
+    std::mutex mutex;
+    pool.parallel_for(points.size(), [&](std::size_t begin, std::size_t end) {
+        std::array<double, 3> rlo = { INF, INF, INF };
+        std::array<double, 3> rhi = { -INF, -INF, -INF };
+        for (auto n = begin; n < end; n++) {
+            std::array<double, 3> x = { points[n].x, points[n].y, points[n].z };
+            for (int d = 0; d < 3; d++) {
+                rlo[d] = std::min(rlo[d], x[d]);
+                rhi[d] = std::max(rhi[d], x[d]);
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int d = 0; d < 3; d++) {
+            lo[d] = std::min(lo[d], rlo[d]);
+            hi[d] = std::max(hi[d], rhi[d]);
+        }
+    });
+    // same scale in all directions, so the curve does not get stretched
+    double extent = 0.;
+    for (int d = 0; d < 3; d++)
+        extent = std::max(extent, hi[d] - lo[d]);
+    return { lo, extent > 0. ? SFC_MAX / extent : 0. };
+}
+
+/// Sort key
+struct KeyIndex {
+    std::uint64_t key;
+    std::size_t index;
+};
+
+/// Sort by key with a parallel (stable) LSD radix sort
+///
+/// Each pass handles 8 bits: chunks of the input are histogrammed in parallel, a prefix sum over
+/// (digit, chunk) gives each chunk its output positions, and chunks are scattered in parallel.
+/// Passes over digits that are the same for all keys are skipped.
+void
+radix_sort(std::vector<KeyIndex> & items, ThreadPool & pool)
+{
+    constexpr int RADIX_BITS = 8;
+    constexpr std::size_t RADIX = 1 << RADIX_BITS;
+    auto n = items.size();
+    std::size_t n_chunks = std::min<std::size_t>(n, 4 * pool.size());
+    if (n_chunks == 0)
+        return;
+    auto chunk_begin = [&](std::size_t c) { return n * c / n_chunks; };
+
+    std::vector<KeyIndex> tmp(n);
+    std::vector<std::array<std::size_t, RADIX>> counts(n_chunks);
+    for (int shift = 0; shift < 64; shift += RADIX_BITS) {
+        pool.parallel_for(n_chunks, [&](std::size_t c_begin, std::size_t c_end) {
+            for (auto c = c_begin; c < c_end; c++) {
+                counts[c].fill(0);
+                for (auto i = chunk_begin(c); i < chunk_begin(c + 1); i++)
+                    counts[c][(items[i].key >> shift) & (RADIX - 1)]++;
+            }
+        });
+
+        std::size_t pos = 0;
+        bool single_digit = false;
+        for (std::size_t d = 0; d < RADIX; d++) {
+            auto start = pos;
+            for (std::size_t c = 0; c < n_chunks; c++) {
+                auto cnt = counts[c][d];
+                counts[c][d] = pos;
+                pos += cnt;
+            }
+            if (pos - start == n)
+                single_digit = true;
+        }
+        if (single_digit)
+            continue;
+
+        pool.parallel_for(n_chunks, [&](std::size_t c_begin, std::size_t c_end) {
+            for (auto c = c_begin; c < c_end; c++)
+                for (auto i = chunk_begin(c); i < chunk_begin(c + 1); i++)
+                    tmp[counts[c][(items[i].key >> shift) & (RADIX - 1)]++] = items[i];
+        });
+        items.swap(tmp);
+    }
+}
+
+/// Order nodes along a space-filling curve through their coordinates
+std::vector<std::size_t>
+sfc_order(const std::pmr::vector<MshFile::Node> & nodes,
+          const std::vector<std::size_t> & offsets,
+          NodeOrdering ordering,
+          ThreadPool & pool)
+{
+    auto points = dense_points(nodes, offsets, pool);
+    auto quantize = make_quantizer(points, pool);
+
+    std::vector<KeyIndex> keys(points.size());
+    pool.parallel_for(points.size(), [&](std::size_t begin, std::size_t end) {
+        for (auto n = begin; n < end; n++) {
+            auto q = quantize(points[n]);
+            keys[n] = { ordering == NodeOrdering::HILBERT ? hilbert_key(q) : morton_key(q), n };
+        }
+    });
+    radix_sort(keys, pool);
+
+    std::vector<std::size_t> order(keys.size());
+    for (std::size_t k = 0; k < keys.size(); k++)
+        order[k] = keys[k].index;
+    return order;
+}
+
+/// Order the vertices of a graph by the reverse Cuthill-McKee algorithm
+///
+/// Each connected component is traversed breadth-first from a pseudo-peripheral vertex (found by
+/// the George-Liu algorithm), visiting neighbors by increasing degree.
+std::vector<std::size_t>
+rcm_order(const Csr & graph)
+{
+    auto n = graph.size();
+    auto by_degree = [&](std::size_t a, std::size_t b) {
+        auto da = graph.degree(a);
+        auto db = graph.degree(b);
+        return da < db || (da == db && a < b);
+    };
+
+    // breadth-first search from `root` collecting the visited vertices into `queue`, returns the
+    // number of levels and sets `last_level` to the start of the last level in `queue`
+    std::vector<std::size_t> queue;
+    std::vector<std::size_t> stamp(n, 0);
+    std::size_t generation = 0;
+    auto bfs = [&](std::size_t root, std::size_t & last_level) {
+        generation++;
+        queue.clear();
+        queue.push_back(root);
+        stamp[root] = generation;
+        std::size_t head = 0;
+        std::size_t n_levels = 0;
+        while (head < queue.size()) {
+            last_level = head;
+            auto level_end = queue.size();
+            for (; head < level_end; head++)
+                for (auto it = graph.begin(queue[head]); it != graph.end(queue[head]); it++)
+                    if (stamp[*it] != generation) {
+                        stamp[*it] = generation;
+                        queue.push_back(*it);
+                    }
+            n_levels++;
+        }
+        return n_levels;
+    };
+
+    std::vector<std::size_t> order;
+    order.reserve(n);
+    std::vector<bool> placed(n, false);
+    for (std::size_t i = 0; i < n; i++) {
+        if (placed[i])
+            continue;
+
+        auto root = i;
+        std::size_t last_level = 0;
+        auto n_levels = bfs(root, last_level);
+        while (true) {
+            auto x = *std::min_element(queue.begin() + last_level, queue.end(), by_degree);
+            std::size_t x_last_level;
+            auto x_levels = bfs(x, x_last_level);
+            if (x_levels <= n_levels)
+                break;
+            root = x;
+            n_levels = x_levels;
+            last_level = x_last_level;
+        }
+
+        auto head = order.size();
+        order.push_back(root);
+        placed[root] = true;
+        for (; head < order.size(); head++) {
+            auto v = order[head];
+            auto first = order.size();
+            for (auto it = graph.begin(v); it != graph.end(v); it++)
+                if (!placed[*it]) {
+                    placed[*it] = true;
+                    order.push_back(*it);
+                }
+            std::sort(order.begin() + first, order.end(), by_degree);
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+/// Reorder `values` made of `stride` entries per item, so that item `i` becomes `order[i]`
+template <typename T>
+void
+permute(std::pmr::vector<T> & values, const std::vector<std::size_t> & order, std::size_t stride)
+{
+    if (values.empty() || stride == 0)
+        return;
+    std::pmr::vector<T> permuted(values.get_allocator());
+    permuted.reserve(values.size());
+    for (auto i : order)
+        permuted.insert(permuted.end(),
+                        values.begin() + i * stride,
+                        values.begin() + (i + 1) * stride);
+    values.swap(permuted);
+}
+
+/// Parallel version of `permute` for large arrays
+template <typename T>
+void
+permute(std::pmr::vector<T> & values,
+        const std::vector<std::size_t> & order,
+        std::size_t stride,
+        ThreadPool & pool)
+{
+    if (values.empty() || stride == 0)
+        return;
+    std::pmr::vector<T> permuted(values.size(), values.get_allocator());
+    pool.parallel_for(order.size(), [&](std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; i++)
+            std::copy_n(values.begin() + order[i] * stride, stride, permuted.begin() + i * stride);
+    });
+    values.swap(permuted);
+}
+
+/// Replace node blocks by a single block holding all nodes in the order given by `perm`
+///
+/// @param nodes Node blocks
+/// @param offsets Offsets of the node blocks
+/// @param perm `perm[k]` is the (original) position of the `k`-th node of the merged block
+/// @param tags Tags of the merged block
+/// @param pool Thread pool
+void
+merge_node_blocks(std::pmr::vector<MshFile::Node> & nodes,
+                  const std::vector<std::size_t> & offsets,
+                  const std::vector<std::size_t> & perm,
+                  const std::vector<int> & tags,
+                  ThreadPool & pool)
+{
+    auto n_nodes = perm.size();
+    // keep single precision only if all nodes are stored in it
+    bool single = n_nodes > 0;
+    int dim = -1;
+    for (auto & blk : nodes) {
+        single &= blk.tags.empty() || !blk.float_coordinates.empty();
+        dim = std::max(dim, blk.dimension);
+    }
+    // block holding position `n` of the original order
+    auto block_of = [&](std::size_t n) {
+        return std::upper_bound(offsets.begin(), offsets.end(), n) - offsets.begin() - 1;
+    };
+
+    std::pmr::vector<MshFile::Node> merged(nodes.get_allocator());
+    auto & node = merged.emplace_back();
+    node.dimension = dim;
+    node.tags.assign(tags.begin(), tags.end());
+    if (single)
+        node.float_coordinates.resize(n_nodes);
+    else
+        node.coordinates.resize(n_nodes);
+    pool.parallel_for(n_nodes, [&](std::size_t begin, std::size_t end) {
+        for (auto k = begin; k < end; k++) {
+            auto b = block_of(perm[k]);
+            auto i = perm[k] - offsets[b];
+            if (single)
+                node.float_coordinates[k] = nodes[b].float_coordinates[i];
+            else
+                node.coordinates[k] = node_point(nodes[b], i);
+        }
+    });
+    nodes.swap(merged);
+}
+
+} // namespace
+
+std::vector<std::size_t>
+reorder_nodes(std::pmr::vector<MshFile::Node> & nodes,
+              std::pmr::vector<MshFile::ElementBlock> & blocks,
+              NodeOrdering ordering,
+              unsigned int num_threads,
+              NodeLayout layout)
+{
+    ThreadPool pool(num_threads);
+    NodeNumbering numbering(nodes);
+    auto offsets = node_block_offsets(nodes);
+    auto n_nodes = offsets.back();
+
+    // check all connectivity before touching anything, so that a failure leaves the mesh as it was
+    for (auto & blk : blocks)
+        pool.parallel_for(blk.connectivity.size(), [&](std::size_t begin, std::size_t end) {
+            for (auto j = begin; j < end; j++)
+                numbering.index(blk.connectivity[j]);
+        });
+
+    std::vector<std::size_t> perm;
+    if (ordering == NodeOrdering::RCM)
+        perm = rcm_order(make_node_graph(numbering, ElementNumbering(blocks), pool));
+    else
+        perm = sfc_order(nodes, offsets, ordering, pool);
+
+    // the `k`-th node in the new order gets the `k`-th smallest tag
+    std::vector<int> sorted_tags(n_nodes);
+    for (std::size_t n = 0; n < n_nodes; n++)
+        sorted_tags[n] = numbering.tag(n);
+    std::sort(sorted_tags.begin(), sorted_tags.end());
+    std::vector<int> new_tags(n_nodes);
+    for (std::size_t k = 0; k < n_nodes; k++)
+        new_tags[perm[k]] = sorted_tags[k];
+
+    for (auto & blk : blocks)
+        pool.parallel_for(blk.connectivity.size(), [&](std::size_t begin, std::size_t end) {
+            for (auto j = begin; j < end; j++)
+                blk.connectivity[j] = new_tags[numbering.find(blk.connectivity[j])];
+        });
+
+    if (layout == NodeLayout::MERGE) {
+        merge_node_blocks(nodes, offsets, perm, sorted_tags, pool);
+        return perm;
+    }
+
+    pool.parallel_for(nodes.size(), [&](std::size_t begin, std::size_t end) {
+        std::vector<std::size_t> order;
+        for (auto b = begin; b < end; b++) {
+            auto & blk = nodes[b];
+            auto first = new_tags.begin() + offsets[b];
+            order.resize(blk.tags.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&](std::size_t i, std::size_t j) {
+                return first[i] < first[j];
+            });
+            for (std::size_t i = 0; i < order.size(); i++)
+                blk.tags[i] = first[order[i]];
+            permute(blk.coordinates, order, 1);
+            permute(blk.float_coordinates, order, 1);
+            permute(blk.par_coords, order, blk.get_num_par_coords());
+            permute(blk.float_par_coords, order, blk.get_num_par_coords());
+        }
+    });
+    return perm;
+}
+
+std::vector<std::vector<std::size_t>>
+reorder_elements(const std::pmr::vector<MshFile::Node> & nodes,
+                 std::pmr::vector<MshFile::ElementBlock> & blocks,
+                 unsigned int num_threads)
+{
+    ThreadPool pool(num_threads);
+    NodeNumbering numbering(nodes);
+    auto points = dense_points(nodes, node_block_offsets(nodes), pool);
+    auto quantize = make_quantizer(points, pool);
+
+    std::vector<std::vector<std::size_t>> perms;
+    perms.reserve(blocks.size());
+    std::vector<KeyIndex> keys;
+    for (auto & blk : blocks) {
+        auto & info = element_info(blk.element_type);
+        if (!info.is_valid())
+            throw Exception("Unknown element type '{}'", blk.element_type);
+        auto n_corners = info.num_corner_nodes;
+        keys.resize(blk.size());
+        pool.parallel_for(blk.size(), [&](std::size_t begin, std::size_t end) {
+            for (auto e = begin; e < end; e++) {
+                auto conn = blk.get_node_tags(e);
+                MshFile::Point c;
+                for (int j = 0; j < n_corners; j++) {
+                    auto & p = points[numbering.index(conn[j])];
+                    c.x += p.x;
+                    c.y += p.y;
+                    c.z += p.z;
+                }
+                c = { c.x / n_corners, c.y / n_corners, c.z / n_corners };
+                keys[e] = { hilbert_key(quantize(c)), e };
+            }
+        });
+        radix_sort(keys, pool);
+
+        std::vector<std::size_t> perm(keys.size());
+        for (std::size_t i = 0; i < keys.size(); i++)
+            perm[i] = keys[i].index;
+        perms.push_back(std::move(perm));
+    }
+
+    // all blocks were checked while computing the permutations, so applying them cannot fail and
+    // leave the mesh half-modified
+    for (std::size_t b = 0; b < blocks.size(); b++) {
+        auto & blk = blocks[b];
+        permute(blk.element_tags, perms[b], 1, pool);
+        permute(blk.connectivity, perms[b], blk.get_num_nodes_per_element(), pool);
+    }
+    return perms;
+}
+
+} // namespace gmshparsercpp
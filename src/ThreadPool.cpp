@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace gmshparsercpp {
+
+ThreadPool::ThreadPool(unsigned int num_threads) : pending(0), stop(false)
+{
+    auto n = resolve_num_threads(num_threads);
+    for (unsigned int i = 0; i < n; i++)
+        this->workers.emplace_back(&ThreadPool::work, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stop = true;
+    }
+    this->task_cv.notify_all();
+    for (auto & w : this->workers)
+        w.join();
+}
+
+unsigned int
+ThreadPool::size() const
+{
+    return this->workers.size();
+}
+
+void
+ThreadPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->tasks.push_back(std::move(task));
+        this->pending++;
+    }
+    this->task_cv.notify_one();
+}
+
+void
+ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->done_cv.wait(lock, [&] { return this->pending == 0; });
+    if (this->error) {
+        auto err = this->error;
+        this->error = nullptr;
+        std::rethrow_exception(err);
+    }
+}
+
+void
+ThreadPool::parallel_for(std::size_t n,
+                         const std::function<void(std::size_t, std::size_t)> & body)
+{
+    // a few ranges per worker even out uneven work
+    std::size_t n_ranges = std::min<std::size_t>(n, 4 * size());
+    for (std::size_t i = 0; i < n_ranges; i++) {
+        auto begin = n * i / n_ranges;
+        auto end = n * (i + 1) / n_ranges;
+        submit([&body, begin, end]() { body(begin, end); });
+    }
+    wait();
+}
+
+unsigned int
+ThreadPool::resolve_num_threads(unsigned int num_threads)
+{
+    if (num_threads == 0)
+        num_threads = std::thread::hardware_concurrency();
+    return num_threads > 0 ? num_threads : 1;
+}
+
+void
+ThreadPool::work()
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->task_cv.wait(lock, [&] { return this->stop || !this->tasks.empty(); });
+            if (this->tasks.empty())
+                return;
+            task = std::move(this->tasks.front());
+            this->tasks.pop_front();
+        }
+
+        std::exception_ptr err;
+        try {
+            task();
+        }
+        catch (...) {
+            err = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            if (err && !this->error)
+                this->error = err;
+            this->pending--;
+            if (this->pending == 0)
+                this->done_cv.notify_all();
+        }
+    }
+}
+
+} // namespace gmshparsercpp
@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gmshparsercpp {
+
+/// Fixed-size pool of worker threads executing submitted tasks
+class ThreadPool {
+public:
+    /// Construct thread pool
+    ///
+    /// @param num_threads Number of worker threads, 0 means one per hardware thread
+    explicit ThreadPool(unsigned int num_threads);
+    ~ThreadPool();
+
+    /// Get the number of worker threads
+    unsigned int size() const;
+
+    /// Queue a task for execution
+    void submit(std::function<void()> task);
+
+    /// Wait until all submitted tasks are done
+    ///
+    /// If a task threw, the first exception is re-thrown from here (remaining tasks still run).
+    void wait();
+
+    /// Run `body` over `[0, n)` split into contiguous ranges and wait for it
+    ///
+    /// @param n Size of the range
+    /// @param body Function called with `[begin, end)` of each sub-range
+    void parallel_for(std::size_t n, const std::function<void(std::size_t, std::size_t)> & body);
+
+    /// Resolve the number of threads, mapping 0 to the number of hardware threads
+    static unsigned int resolve_num_threads(unsigned int num_threads);
+
+private:
+    /// Body of a worker thread
+    void work();
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    /// Signals workers that a task is available or the pool is shutting down
+    std::condition_variable task_cv;
+    /// Signals `wait` that all tasks are done
+    std::condition_variable done_cv;
+    /// Number of tasks queued or running
+    std::size_t pending;
+    /// First error raised by a task
+    std::exception_ptr error;
+    /// Flag asking the workers to quit
+    bool stop;
+};
+
+} // namespace gmshparsercpp
@@ -0,0 +1,260 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "TokenScanner.h"
+#include <algorithm>
+#if defined(__SSE2__) || defined(_M_X64)
+    #define GMSHPARSERCPP_SCANNER_SSE2
+    #include <emmintrin.h>
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    // compiled with a function-level target, so the rest of the library does not need -mavx2
+    #define GMSHPARSERCPP_SCANNER_AVX2
+    #include <immintrin.h>
+#endif
+
+namespace gmshparsercpp {
+
+namespace {
+
+inline bool
+is_whitespace(char ch)
+{
+    return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';
+}
+
+inline unsigned int
+count_trailing_zeros(std::uint32_t x)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(x);
+#else
+    unsigned int n = 0;
+    while ((x & 1) == 0) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/// White space mask of `n` bytes (bit `i` set if `p[i]` is white space)
+inline std::uint32_t
+scalar_mask(const char * p, std::size_t n)
+{
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < n; i++)
+        if (is_whitespace(p[i]))
+            mask |= std::uint32_t(1) << i;
+    return mask;
+}
+
+/// Byte-at-a-time classification
+struct ScalarMask {
+    static constexpr std::size_t WIDTH = 16;
+
+    static std::uint32_t
+    whitespace(const char * p)
+    {
+        return scalar_mask(p, WIDTH);
+    }
+};
+
+#ifdef GMSHPARSERCPP_SCANNER_SSE2
+struct Sse2Mask {
+    static constexpr std::size_t WIDTH = 16;
+
+    static std::uint32_t
+    whitespace(const char * p)
+    {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        auto m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                                           _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+                              _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')),
+                                           _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(m));
+    }
+};
+#endif
+
+#ifdef GMSHPARSERCPP_SCANNER_AVX2
+struct Avx2Mask {
+    static constexpr std::size_t WIDTH = 32;
+
+    __attribute__((target("avx2"))) static std::uint32_t
+    whitespace(const char * p)
+    {
+        auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        auto m = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+                                                 _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))),
+                                 _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')),
+                                                 _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'))));
+        return static_cast<std::uint32_t>(_mm256_movemask_epi8(m));
+    }
+};
+#endif
+
+/// Scanner algorithms, generic in the way white space masks are computed
+template <typename MASK>
+struct Scanner {
+    static constexpr std::size_t W = MASK::WIDTH;
+
+    static const char *
+    skip_whitespace(const char * p, const char * end)
+    {
+        for (; end - p >= std::ptrdiff_t(W); p += W) {
+            auto mask = ~MASK::whitespace(p) & full_mask(W);
+            if (mask)
+                return p + count_trailing_zeros(mask);
+        }
+        while (p < end && is_whitespace(*p))
+            p++;
+        return p;
+    }
+
+    static const char *
+    find_whitespace(const char * p, const char * end)
+    {
+        for (; end - p >= std::ptrdiff_t(W); p += W) {
+            auto mask = MASK::whitespace(p);
+            if (mask)
+                return p + count_trailing_zeros(mask);
+        }
+        while (p < end && !is_whitespace(*p))
+            p++;
+        return p;
+    }
+
+    static std::size_t
+    scan_tokens(const char * begin,
+                const char * end,
+                std::uint32_t * starts,
+                std::uint32_t * ends,
+                std::size_t max_tokens)
+    {
+        std::size_t n_starts = 0;
+        std::size_t n_ends = 0;
+        // 1 if the byte before the current chunk belongs to a token
+        std::uint32_t carry = 0;
+        for (const char * p = begin; p < end && n_ends < max_tokens; p += W) {
+            std::size_t len = std::min<std::size_t>(W, end - p);
+            auto valid = full_mask(len);
+            auto ws = len == W ? MASK::whitespace(p) : scalar_mask(p, len);
+            auto non_ws = ~ws & valid;
+            auto prev = (non_ws << 1) | carry;
+            // token starts where non-white space follows white space, ends the other way around
+            auto start_bits = non_ws & ~prev;
+            auto end_bits = ws & valid & prev;
+            std::uint32_t offset = p - begin;
+            for (; start_bits && n_starts < max_tokens; start_bits &= start_bits - 1)
+                starts[n_starts++] = offset + count_trailing_zeros(start_bits);
+            for (; end_bits && n_ends < max_tokens; end_bits &= end_bits - 1)
+                ends[n_ends++] = offset + count_trailing_zeros(end_bits);
+            carry = (non_ws >> (len - 1)) & 1;
+        }
+        return n_ends;
+    }
+
+private:
+    static std::uint32_t
+    full_mask(std::size_t n)
+    {
+        return n >= 32 ? ~std::uint32_t(0) : (std::uint32_t(1) << n) - 1;
+    }
+};
+
+template <typename MASK>
+constexpr TokenScanner
+make_scanner(ScannerIsa isa)
+{
+    return { isa,
+             &Scanner<MASK>::skip_whitespace,
+             &Scanner<MASK>::find_whitespace,
+             &Scanner<MASK>::scan_tokens };
+}
+
+#ifdef GMSHPARSERCPP_SCANNER_AVX2
+// entry points with the AVX2 target, so that the generic algorithms get inlined into them and the
+// mask computation is inlined into the loops
+
+__attribute__((target("avx2"), flatten)) const char *
+skip_whitespace_avx2(const char * p, const char * end)
+{
+    return Scanner<Avx2Mask>::skip_whitespace(p, end);
+}
+
+__attribute__((target("avx2"), flatten)) const char *
+find_whitespace_avx2(const char * p, const char * end)
+{
+    return Scanner<Avx2Mask>::find_whitespace(p, end);
+}
+
+__attribute__((target("avx2"), flatten)) std::size_t
+scan_tokens_avx2(const char * begin,
+                 const char * end,
+                 std::uint32_t * starts,
+                 std::uint32_t * ends,
+                 std::size_t max_tokens)
+{
+    return Scanner<Avx2Mask>::scan_tokens(begin, end, starts, ends, max_tokens);
+}
+
+bool
+cpu_has_avx2()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+#endif
+
+const TokenScanner SCALAR_SCANNER = make_scanner<ScalarMask>(ScannerIsa::SCALAR);
+#ifdef GMSHPARSERCPP_SCANNER_SSE2
+const TokenScanner SSE2_SCANNER = make_scanner<Sse2Mask>(ScannerIsa::SSE2);
+#endif
+#ifdef GMSHPARSERCPP_SCANNER_AVX2
+const TokenScanner AVX2_SCANNER = { ScannerIsa::AVX2,
+                                    &skip_whitespace_avx2,
+                                    &find_whitespace_avx2,
+                                    &scan_tokens_avx2 };
+#endif
+
+} // namespace
+
+const TokenScanner *
+token_scanner(ScannerIsa isa)
+{
+    switch (isa) {
+    case ScannerIsa::SCALAR:
+        return &SCALAR_SCANNER;
+    case ScannerIsa::SSE2:
+#ifdef GMSHPARSERCPP_SCANNER_SSE2
+        return &SSE2_SCANNER;
+#else
+        return nullptr;
+#endif
+    case ScannerIsa::AVX2:
+#ifdef GMSHPARSERCPP_SCANNER_AVX2
+    {
+        static const bool has_avx2 = cpu_has_avx2();
+        return has_avx2 ? &AVX2_SCANNER : nullptr;
+    }
+#else
+        return nullptr;
+#endif
+    }
+    return nullptr;
+}
+
+const TokenScanner &
+token_scanner()
+{
+    static const TokenScanner * best = []() {
+        for (auto isa : { ScannerIsa::AVX2, ScannerIsa::SSE2 })
+            if (auto scanner = token_scanner(isa))
+                return scanner;
+        return &SCALAR_SCANNER;
+    }();
+    return *best;
+}
+
+} // namespace gmshparsercpp
@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gmshparsercpp {
+
+/// Instruction set a token scanner is implemented with
+enum class ScannerIsa { SCALAR, SSE2, AVX2 };
+
+/// Functions locating token boundaries in ASCII data
+///
+/// Tokens are separated by white space (space, tab, carriage return, line feed). The SIMD
+/// implementations classify 16 (SSE2) or 32 (AVX2) bytes at a time.
+struct TokenScanner {
+    /// Instruction set
+    ScannerIsa isa;
+
+    /// Find the first character in `[begin, end)` that is not white space (`end` if none)
+    const char * (*skip_whitespace)(const char * begin, const char * end);
+
+    /// Find the first white space character in `[begin, end)` (`end` if none)
+    const char * (*find_whitespace)(const char * begin, const char * end);
+
+    /// Locate complete tokens in `[begin, end)`
+    ///
+    /// `begin` must be at a token boundary. A token is complete when white space follows it, so a
+    /// token running up to `end` is not reported.
+    ///
+    /// @param begin Start of the data
+    /// @param end End of the data
+    /// @param starts Receives offsets (from `begin`) of the first character of each token
+    /// @param ends Receives offsets of the white space character following each token
+    /// @param max_tokens Maximum number of tokens to locate
+    /// @return Number of tokens located
+    std::size_t (*scan_tokens)(const char * begin,
+                               const char * end,
+                               std::uint32_t * starts,
+                               std::uint32_t * ends,
+                               std::size_t max_tokens);
+};
+
+/// Get the fastest token scanner the CPU supports (detected once, at first use)
+const TokenScanner & token_scanner();
+
+/// Get the token scanner for an instruction set
+///
+/// @param isa Instruction set
+/// @return The scanner, `nullptr` if the build or the CPU does not support `isa`
+const TokenScanner * token_scanner(ScannerIsa isa);
+
+} // namespace gmshparsercpp
@@ -0,0 +1,765 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "gmshparsercpp/Topology.h"
+#include "gmshparsercpp/Exception.h"
+#include "NodeGraph.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <utility>
+
+namespace gmshparsercpp {
+
+namespace {
+
+/// Side of an element, given by local indices of its corner nodes
+struct Side {
+    int num_nodes = 0;
+    std::array<int, 4> nodes {};
+};
+
+/// Sides of an element type
+struct SideList {
+    int num_sides = 0;
+    std::array<Side, 12> sides {};
+};
+
+/// Number of bits of a side reference holding the local side index
+constexpr int SIDE_BITS = 4;
+/// Number of buckets sides are distributed into (by the top bits of their hash)
+constexpr std::size_t NUM_BUCKETS = 256;
+
+/// Get the sides of dimension `side_dim` of an element type
+SideList
+side_list(ElementType type, int side_dim)
+{
+    auto & info = element_info(type);
+    auto & topo = reference_topology(info.family);
+    SideList sl;
+    if (side_dim == 2) {
+        for (int i = 0; i < topo.num_faces; i++) {
+            auto & face = topo.faces[i];
+            sl.sides[sl.num_sides++] = { face.num_nodes, face.nodes };
+        }
+    }
+    else if (side_dim == 1) {
+        for (int i = 0; i < topo.num_edges; i++)
+            sl.sides[sl.num_sides++] = { 2, { topo.edges[i][0], topo.edges[i][1] } };
+    }
+    else if (side_dim == 0) {
+        for (int i = 0; i < info.num_corner_nodes; i++)
+            sl.sides[sl.num_sides++] = { 1, { i } };
+    }
+    return sl;
+}
+
+/// Call `body(e, k, i)` for elements `[begin, end)`, where `e` is element `i` of selected block `k`
+template <typename BODY>
+void
+for_each_element(const ElementNumbering & elements, std::size_t begin, std::size_t end, BODY body)
+{
+    if (begin >= end)
+        return;
+    auto k = elements.find_block(begin);
+    for (auto e = begin; e < end; e++) {
+        while (e >= elements.offset(k + 1))
+            k++;
+        body(e, k, e - elements.offset(k));
+    }
+}
+
+/// Sort the rows of a CSR relation and drop duplicate entries
+void
+sort_unique_rows(Csr & csr, ThreadPool & pool)
+{
+    auto n = csr.size();
+    std::vector<std::size_t> lengths(n);
+    pool.parallel_for(n, [&](std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; i++) {
+            auto first = csr.indices.begin() + csr.offsets[i];
+            auto last = csr.indices.begin() + csr.offsets[i + 1];
+            std::sort(first, last);
+            lengths[i] = std::unique(first, last) - first;
+        }
+    });
+
+    std::vector<std::size_t> offsets(n + 1);
+    offsets[0] = 0;
+    for (std::size_t i = 0; i < n; i++)
+        offsets[i + 1] = offsets[i] + lengths[i];
+    if (offsets[n] == csr.indices.size())
+        return;
+    std::vector<std::size_t> indices(offsets[n]);
+    pool.parallel_for(n, [&](std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; i++)
+            std::copy_n(csr.indices.begin() + csr.offsets[i],
+                        lengths[i],
+                        indices.begin() + offsets[i]);
+    });
+    csr.offsets = std::move(offsets);
+    csr.indices = std::move(indices);
+}
+
+/// Sides of all elements grouped by their corner nodes
+///
+/// A side is identified by a reference `e << SIDE_BITS | s` (side `s` of element `e`) and keyed by
+/// a hash of its sorted corner node indices. Only the 16-byte (hash, reference) pairs are stored;
+/// corner nodes are looked up in the connectivity when sides with equal hashes are compared. Sides
+/// are distributed into buckets by hash with a parallel counting sort, so buckets can be sorted
+/// and scanned independently.
+class SideTable {
+public:
+    struct Entry {
+        std::uint64_t hash;
+        std::uint64_t ref;
+
+        bool
+        operator<(const Entry & other) const
+        {
+            return this->hash < other.hash || (this->hash == other.hash && this->ref < other.ref);
+        }
+    };
+
+    /// Sorted corner node indices of a side
+    struct Key {
+        int num_nodes = 0;
+        std::array<std::size_t, 4> nodes {};
+
+        bool
+        operator==(const Key & other) const
+        {
+            return this->num_nodes == other.num_nodes && this->nodes == other.nodes;
+        }
+
+        bool
+        operator<(const Key & other) const
+        {
+            return this->num_nodes < other.num_nodes ||
+                   (this->num_nodes == other.num_nodes && this->nodes < other.nodes);
+        }
+    };
+
+    /// Collect sides of all elements
+    ///
+    /// @param nodes Node numbering
+    /// @param elements Elements
+    /// @param side_lists Sides of each selected block
+    /// @param pool Thread pool
+    SideTable(const NodeNumbering & nodes,
+              const ElementNumbering & elements,
+              std::vector<SideList> side_lists,
+              ThreadPool & pool);
+
+    /// Call `func(bucket, first, last)` for every group `[first, last)` of identical sides
+    ///
+    /// Buckets are processed concurrently, groups of one bucket by the same thread. Groups are
+    /// visited in the same order on every call.
+    template <typename FUNC>
+    void for_each_group(FUNC func) const;
+
+    /// Get the element of a side reference
+    static std::size_t
+    element(std::uint64_t ref)
+    {
+        return ref >> SIDE_BITS;
+    }
+
+    /// Get the local side index of a side reference
+    static int
+    local_side(std::uint64_t ref)
+    {
+        return ref & ((1 << SIDE_BITS) - 1);
+    }
+
+    /// Get the key of side `s` of element `i` of selected block `k`
+    Key key(std::size_t k, std::size_t i, int s) const;
+
+    /// Get the key of a side reference
+    Key key(std::uint64_t ref) const;
+
+private:
+    static std::uint64_t hash(const Key & key);
+
+    static std::size_t
+    bucket(std::uint64_t hash)
+    {
+        return hash >> 56;
+    }
+
+    const NodeNumbering & nodes;
+    const ElementNumbering & elements;
+    std::vector<SideList> side_lists;
+    ThreadPool & pool;
+    /// Sides ordered by bucket, then by hash, corner nodes and reference
+    std::vector<Entry> entries;
+    /// Start of each bucket in `entries`
+    std::array<std::size_t, NUM_BUCKETS + 1> bucket_offsets;
+};
+
+SideTable::SideTable(const NodeNumbering & nodes,
+                     const ElementNumbering & elements,
+                     std::vector<SideList> side_lists,
+                     ThreadPool & pool) :
+    nodes(nodes),
+    elements(elements),
+    side_lists(std::move(side_lists)),
+    pool(pool)
+{
+    using Counts = std::array<std::size_t, NUM_BUCKETS>;
+
+    auto n_elems = elements.size();
+    auto n_chunks = std::max<std::size_t>(1, std::min<std::size_t>(n_elems, 4 * pool.size()));
+    auto chunk_begin = [&](std::size_t c) { return n_elems * c / n_chunks; };
+    auto for_each_side = [&](std::size_t c, auto body) {
+        for_each_element(elements,
+                         chunk_begin(c),
+                         chunk_begin(c + 1),
+                         [&](std::size_t e, std::size_t k, std::size_t i) {
+                             auto & sl = this->side_lists[k];
+                             for (int s = 0; s < sl.num_sides; s++)
+                                 body(Entry { hash(key(k, i, s)), e << SIDE_BITS | s });
+                         });
+    };
+
+    // counting pass, per chunk and bucket
+    std::vector<Counts> cursors(n_chunks, Counts {});
+    for (std::size_t c = 0; c < n_chunks; c++)
+        pool.submit([&, c]() {
+            for_each_side(c, [&](const Entry & entry) { cursors[c][bucket(entry.hash)]++; });
+        });
+    pool.wait();
+
+    std::size_t pos = 0;
+    for (std::size_t b = 0; b < NUM_BUCKETS; b++) {
+        this->bucket_offsets[b] = pos;
+        for (std::size_t c = 0; c < n_chunks; c++)
+            pos += std::exchange(cursors[c][b], pos);
+    }
+    this->bucket_offsets[NUM_BUCKETS] = pos;
+
+    // scatter pass
+    this->entries.resize(pos);
+    for (std::size_t c = 0; c < n_chunks; c++)
+        pool.submit([&, c]() {
+            for_each_side(c, [&](const Entry & entry) {
+                this->entries[cursors[c][bucket(entry.hash)]++] = entry;
+            });
+        });
+    pool.wait();
+
+    // sort buckets, ordering sides with equal hashes by their corner nodes
+    pool.parallel_for(NUM_BUCKETS, [&](std::size_t b_begin, std::size_t b_end) {
+        std::vector<std::pair<Key, Entry>> run;
+        for (auto b = b_begin; b < b_end; b++) {
+            auto first = this->entries.begin() + this->bucket_offsets[b];
+            auto last = this->entries.begin() + this->bucket_offsets[b + 1];
+            std::sort(first, last);
+            while (first != last) {
+                auto run_end = first + 1;
+                while (run_end != last && run_end->hash == first->hash)
+                    run_end++;
+                if (run_end - first > 1) {
+                    run.clear();
+                    for (auto it = first; it != run_end; it++)
+                        run.emplace_back(key(it->ref), *it);
+                    std::sort(run.begin(), run.end(), [](const auto & a, const auto & b) {
+                        return a.first < b.first || (a.first == b.first && a.second < b.second);
+                    });
+                    auto it = first;
+                    for (auto & r : run)
+                        *it++ = r.second;
+                }
+                first = run_end;
+            }
+        }
+    });
+}
+
+SideTable::Key
+SideTable::key(std::uint64_t ref) const
+{
+    auto e = element(ref);
+    auto k = this->elements.find_block(e);
+    return key(k, e - this->elements.offset(k), local_side(ref));
+}
+
+SideTable::Key
+SideTable::key(std::size_t k, std::size_t i, int s) const
+{
+    auto & side = this->side_lists[k].sides[s];
+    auto conn = this->elements.block(k).get_node_tags(i);
+    Key key;
+    key.num_nodes = side.num_nodes;
+    // unused slots sort to the end, so the 4-node sorting network works for any side
+    key.nodes.fill(std::numeric_limits<std::size_t>::max());
+    for (int j = 0; j < std::min(side.num_nodes, 4); j++)
+        key.nodes[j] = this->nodes.index(conn[side.nodes[j]]);
+    auto & n = key.nodes;
+    auto cmp_swap = [&](int a, int b) {
+        if (n[b] < n[a])
+            std::swap(n[a], n[b]);
+    };
+    cmp_swap(0, 1);
+    cmp_swap(2, 3);
+    cmp_swap(0, 2);
+    cmp_swap(1, 3);
+    cmp_swap(1, 2);
+    return key;
+}
+
+std::uint64_t
+SideTable::hash(const Key & key)
+{
+    // splitmix64 finalizer applied to each node in turn
+    std::uint64_t h = key.num_nodes;
+    for (int j = 0; j < key.num_nodes; j++) {
+        h = (h ^ key.nodes[j]) + 0x9e3779b97f4a7c15ULL;
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+        h ^= h >> 31;
+    }
+    return h;
+}
+
+template <typename FUNC>
+void
+SideTable::for_each_group(FUNC func) const
+{
+    this->pool.parallel_for(NUM_BUCKETS, [&](std::size_t b_begin, std::size_t b_end) {
+        for (auto b = b_begin; b < b_end; b++) {
+            auto first = this->entries.data() + this->bucket_offsets[b];
+            auto last = this->entries.data() + this->bucket_offsets[b + 1];
+            while (first != last) {
+                auto group_end = first + 1;
+                if (group_end != last && group_end->hash == first->hash) {
+                    // equal hashes, compare the actual corner nodes
+                    auto first_key = key(first->ref);
+                    while (group_end != last && group_end->hash == first->hash &&
+                           key(group_end->ref) == first_key)
+                        group_end++;
+                }
+                func(b, first, group_end);
+                first = group_end;
+            }
+        }
+    });
+}
+
+/// Get the sides of each selected block matched for a kind of connection
+std::vector<SideList>
+side_lists(const ElementNumbering & elements, DualGraphConnection connection)
+{
+    std::vector<SideList> side_lists;
+    for (std::size_t k = 0; k < elements.num_blocks(); k++) {
+        auto & info = element_info(elements.block(k).element_type);
+        if (!info.is_valid())
+            throw Exception("Unknown element type '{}'", elements.block(k).element_type);
+        int side_dim = connection == DualGraphConnection::FACE ? info.dimension - 1
+                                                               : (info.dimension >= 1 ? 1 : -1);
+        side_lists.push_back(side_list(info.type, side_dim));
+    }
+    return side_lists;
+}
+
+/// Build dual graph from elements sharing a side
+Csr
+build_dual_graph_from_sides(const NodeNumbering & nodes,
+                            const ElementNumbering & elements,
+                            DualGraphConnection connection,
+                            ThreadPool & pool)
+{
+    SideTable table(nodes, elements, side_lists(elements, connection), pool);
+
+    // `func(element, neighbor)` for every pair of distinct elements sharing a side
+    using Entry = SideTable::Entry;
+    auto for_each_neighbor = [&](auto func) {
+        table.for_each_group([&](std::size_t, const Entry * first, const Entry * last) {
+            for (auto a = first; a != last; a++)
+                for (auto c = first; c != last; c++) {
+                    auto ea = SideTable::element(a->ref);
+                    auto ec = SideTable::element(c->ref);
+                    if (ea != ec)
+                        func(ea, ec);
+                }
+        });
+    };
+
+    // count degrees, then scatter neighbors straight into the CSR
+    auto n_elems = elements.size();
+    Csr csr;
+    std::vector<std::atomic<std::size_t>> counts(n_elems);
+    for_each_neighbor([&](std::size_t e, std::size_t) {
+        counts[e].fetch_add(1, std::memory_order_relaxed);
+    });
+    csr.offsets.resize(n_elems + 1);
+    csr.offsets[0] = 0;
+    for (std::size_t i = 0; i < n_elems; i++) {
+        csr.offsets[i + 1] = csr.offsets[i] + counts[i].load(std::memory_order_relaxed);
+        counts[i].store(csr.offsets[i], std::memory_order_relaxed);
+    }
+    csr.indices.resize(csr.offsets[n_elems]);
+    for_each_neighbor([&](std::size_t e, std::size_t n) {
+        csr.indices[counts[e].fetch_add(1, std::memory_order_relaxed)] = n;
+    });
+    // elements sharing more than one edge appear more than once
+    sort_unique_rows(csr, pool);
+    return csr;
+}
+
+/// Build node-to-element adjacency on a thread pool
+Csr
+make_node_to_element(const NodeNumbering & nodes,
+                     const ElementNumbering & elements,
+                     ThreadPool & pool)
+{
+    // `body` gets the node indices of element `e`
+    auto for_each_element_node = [&](auto body) {
+        pool.parallel_for(elements.size(), [&](std::size_t begin, std::size_t end) {
+            for_each_element(elements,
+                             begin,
+                             end,
+                             [&](std::size_t e, std::size_t k, std::size_t i) {
+                                 auto & blk = elements.block(k);
+                                 auto npe = blk.get_num_nodes_per_element();
+                                 auto conn = blk.get_node_tags(i);
+                                 for (int j = 0; j < npe; j++)
+                                     body(e, nodes.index(conn[j]));
+                             });
+        });
+    };
+
+    Csr csr;
+    auto n_nodes = nodes.size();
+    {
+        std::vector<std::atomic<std::size_t>> counts(n_nodes);
+        for_each_element_node([&](std::size_t, std::size_t n) {
+            counts[n].fetch_add(1, std::memory_order_relaxed);
+        });
+        csr.offsets.resize(n_nodes + 1);
+        csr.offsets[0] = 0;
+        for (std::size_t i = 0; i < n_nodes; i++)
+            csr.offsets[i + 1] = csr.offsets[i] + counts[i].load(std::memory_order_relaxed);
+    }
+
+    csr.indices.resize(csr.offsets[n_nodes]);
+    {
+        std::vector<std::atomic<std::size_t>> cursor(n_nodes);
+        for (std::size_t i = 0; i < n_nodes; i++)
+            cursor[i].store(csr.offsets[i], std::memory_order_relaxed);
+        for_each_element_node([&](std::size_t e, std::size_t n) {
+            csr.indices[cursor[n].fetch_add(1, std::memory_order_relaxed)] = e;
+        });
+    }
+
+    // the fill pass puts elements in a row in arbitrary order
+    pool.parallel_for(n_nodes, [&](std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; i++)
+            std::sort(csr.indices.begin() + csr.offsets[i],
+                      csr.indices.begin() + csr.offsets[i + 1]);
+    });
+    return csr;
+}
+
+/// Build a CSR relation from rows computed twice (once to size, once to fill)
+///
+/// @param n Number of rows
+/// @param for_each_row Function calling `body(i, row)` for each row `i` in `[begin, end)`, where
+///                     `row` is a `std::vector<std::size_t>`
+template <typename FOR_EACH_ROW>
+Csr
+make_csr(std::size_t n, ThreadPool & pool, FOR_EACH_ROW for_each_row)
+{
+    Csr csr;
+    csr.offsets.resize(n + 1);
+    csr.offsets[0] = 0;
+    pool.parallel_for(n, [&](std::size_t begin, std::size_t end) {
+        for_each_row(begin, end, [&](std::size_t i, const std::vector<std::size_t> & row) {
+            csr.offsets[i + 1] = row.size();
+        });
+    });
+    for (std::size_t i = 0; i < n; i++)
+        csr.offsets[i + 1] += csr.offsets[i];
+    csr.indices.resize(csr.offsets[n]);
+    pool.parallel_for(n, [&](std::size_t begin, std::size_t end) {
+        for_each_row(begin, end, [&](std::size_t i, const std::vector<std::size_t> & row) {
+            std::copy(row.begin(), row.end(), csr.indices.begin() + csr.offsets[i]);
+        });
+    });
+    return csr;
+}
+
+/// Build dual graph from elements sharing a vertex
+Csr
+build_dual_graph_from_vertices(const NodeNumbering & nodes,
+                               const ElementNumbering & elements,
+                               ThreadPool & pool)
+{
+    auto n2e = make_node_to_element(nodes, elements, pool);
+    auto n_elems = elements.size();
+
+    // neighbors of the elements `[begin, end)`, passed to `body(e, first, last)`
+    auto for_each_row = [&](std::size_t begin, std::size_t end, auto body) {
+        std::vector<std::size_t> nbrs;
+        for_each_element(elements, begin, end, [&](std::size_t e, std::size_t k, std::size_t i) {
+            auto & blk = elements.block(k);
+            auto n_corners = element_info(blk.element_type).num_corner_nodes;
+            auto conn = blk.get_node_tags(i);
+            nbrs.clear();
+            for (int j = 0; j < n_corners; j++) {
+                auto n = nodes.index(conn[j]);
+                nbrs.insert(nbrs.end(), n2e.begin(n), n2e.end(n));
+            }
+            std::sort(nbrs.begin(), nbrs.end());
+            nbrs.erase(std::unique(nbrs.begin(), nbrs.end()), nbrs.end());
+            nbrs.erase(std::lower_bound(nbrs.begin(), nbrs.end(), e));
+            body(e, nbrs);
+        });
+    };
+
+    return make_csr(n_elems, pool, for_each_row);
+}
+
+} // namespace
+
+NodeNumbering::NodeNumbering(const std::pmr::vector<MshFile::Node> & nodes) : min_tag(0)
+{
+    std::size_t n = 0;
+    long long min_tag = std::numeric_limits<long long>::max();
+    long long max_tag = std::numeric_limits<long long>::min();
+    for (auto & blk : nodes) {
+        n += blk.tags.size();
+        for (auto t : blk.tags) {
+            min_tag = std::min<long long>(min_tag, t);
+            max_tag = std::max<long long>(max_tag, t);
+        }
+    }
+    if (n == 0)
+        return;
+
+    this->tags.reserve(n);
+    auto range = static_cast<unsigned long long>(max_tag - min_tag) + 1;
+    if (range <= DENSE_RANGE_FACTOR * n) {
+        this->min_tag = min_tag;
+        this->indices.assign(range, INVALID);
+        for (auto & blk : nodes) {
+            for (auto t : blk.tags) {
+                auto & idx = this->indices[t - min_tag];
+                if (idx != INVALID)
+                    throw Exception("Duplicate node tag '{}'.", t);
+                idx = this->tags.size();
+                this->tags.push_back(t);
+            }
+        }
+    }
+    else {
+        this->sorted.reserve(n);
+        for (auto & blk : nodes) {
+            for (auto t : blk.tags) {
+                this->sorted.emplace_back(t, this->tags.size());
+                this->tags.push_back(t);
+            }
+        }
+        std::sort(this->sorted.begin(), this->sorted.end());
+        auto dup = std::adjacent_find(this->sorted.begin(),
+                                      this->sorted.end(),
+                                      [](auto & a, auto & b) { return a.first == b.first; });
+        if (dup != this->sorted.end())
+            throw Exception("Duplicate node tag '{}'.", dup->first);
+    }
+}
+
+std::size_t
+NodeNumbering::find_sorted(int tag) const
+{
+    auto it = std::lower_bound(this->sorted.begin(),
+                               this->sorted.end(),
+                               tag,
+                               [](auto & entry, int t) { return entry.first < t; });
+    return it != this->sorted.end() && it->first == tag ? it->second : INVALID;
+}
+
+std::size_t
+NodeNumbering::index(int tag) const
+{
+    auto idx = find(tag);
+    if (idx == INVALID)
+        throw Exception("Unknown node tag '{}'.", tag);
+    return idx;
+}
+
+ElementNumbering::ElementNumbering(const std::pmr::vector<MshFile::ElementBlock> & blocks,
+                                   const std::vector<std::size_t> & selection) :
+    blocks(&blocks),
+    selection(selection)
+{
+    if (this->selection.empty()) {
+        this->selection.resize(blocks.size());
+        std::iota(this->selection.begin(), this->selection.end(), 0);
+    }
+    this->offsets.reserve(this->selection.size() + 1);
+    this->offsets.push_back(0);
+    for (auto k : this->selection) {
+        if (k >= blocks.size())
+            throw Exception("Element block index '{}' is out of range.", k);
+        this->offsets.push_back(this->offsets.back() + blocks[k].size());
+    }
+}
+
+std::size_t
+ElementNumbering::find_block(std::size_t e) const
+{
+    if (e >= size())
+        throw Exception("Element '{}' is out of range.", e);
+    auto it = std::upper_bound(this->offsets.begin(), this->offsets.end(), e);
+    return (it - this->offsets.begin()) - 1;
+}
+
+Csr
+build_node_to_element(const NodeNumbering & nodes,
+                      const ElementNumbering & elements,
+                      unsigned int num_threads)
+{
+    ThreadPool pool(num_threads);
+    return make_node_to_element(nodes, elements, pool);
+}
+
+Csr
+make_node_graph(const NodeNumbering & nodes,
+                const ElementNumbering & elements,
+                ThreadPool & pool)
+{
+    auto n2e = make_node_to_element(nodes, elements, pool);
+
+    auto for_each_row = [&](std::size_t begin, std::size_t end, auto body) {
+        std::vector<std::size_t> nbrs;
+        for (auto n = begin; n < end; n++) {
+            nbrs.clear();
+            for (auto it = n2e.begin(n); it != n2e.end(n); it++) {
+                auto k = elements.find_block(*it);
+                auto & blk = elements.block(k);
+                auto npe = blk.get_num_nodes_per_element();
+                auto conn = blk.get_node_tags(*it - elements.offset(k));
+                for (int j = 0; j < npe; j++)
+                    nbrs.push_back(nodes.index(conn[j]));
+            }
+            std::sort(nbrs.begin(), nbrs.end());
+            nbrs.erase(std::unique(nbrs.begin(), nbrs.end()), nbrs.end());
+            auto self = std::lower_bound(nbrs.begin(), nbrs.end(), n);
+            if (self != nbrs.end() && *self == n)
+                nbrs.erase(self);
+            body(n, nbrs);
+        }
+    };
+    return make_csr(nodes.size(), pool, for_each_row);
+}
+
+Csr
+build_node_graph(const NodeNumbering & nodes,
+                 const ElementNumbering & elements,
+                 unsigned int num_threads)
+{
+    ThreadPool pool(num_threads);
+    return make_node_graph(nodes, elements, pool);
+}
+
+Csr
+build_dual_graph(const NodeNumbering & nodes,
+                 const ElementNumbering & elements,
+                 DualGraphConnection connection,
+                 unsigned int num_threads)
+{
+    ThreadPool pool(num_threads);
+    if (connection == DualGraphConnection::VERTEX)
+        return build_dual_graph_from_vertices(nodes, elements, pool);
+    else
+        return build_dual_graph_from_sides(nodes, elements, connection, pool);
+}
+
+std::vector<BoundarySides>
+extract_boundary(const NodeNumbering & nodes,
+                 const ElementNumbering & elements,
+                 unsigned int num_threads)
+{
+    ThreadPool pool(num_threads);
+    auto sl = side_lists(elements, DualGraphConnection::FACE);
+    SideTable table(nodes, elements, sl, pool);
+
+    // sides not shared with another element
+    std::vector<std::vector<std::uint64_t>> refs(NUM_BUCKETS);
+    using Entry = SideTable::Entry;
+    table.for_each_group([&](std::size_t b, const Entry * first, const Entry * last) {
+        if (last - first == 1)
+            refs[b].push_back(first->ref);
+    });
+    std::vector<std::uint64_t> bnd;
+    for (auto & r : refs) {
+        bnd.insert(bnd.end(), r.begin(), r.end());
+        std::vector<std::uint64_t>().swap(r);
+    }
+    std::sort(bnd.begin(), bnd.end());
+
+    // one output block per selected block and side type, `slot[k][n]` for sides with `n` corners
+    static const ElementType SIDE_TYPES[] = { NONE, POINT, LINE2, TRI3, QUAD4 };
+    std::vector<BoundarySides> result;
+    std::vector<std::array<std::size_t, 5>> slot(elements.num_blocks());
+    std::vector<std::size_t> counts;
+    for (std::size_t k = 0; k < elements.num_blocks(); k++) {
+        for (int n = 1; n <= 4; n++) {
+            slot[k][n] = result.size();
+            for (int s = 0; s < sl[k].num_sides; s++)
+                if (sl[k].sides[s].num_nodes == n) {
+                    BoundarySides bs;
+                    bs.block.dimension = element_info(elements.block(k).element_type).dimension - 1;
+                    bs.block.tag = elements.block(k).tag;
+                    bs.block.element_type = SIDE_TYPES[n];
+                    bs.parent_block = k;
+                    result.push_back(std::move(bs));
+                    counts.push_back(0);
+                    break;
+                }
+        }
+    }
+
+    auto locate = [&](std::uint64_t ref) {
+        auto e = SideTable::element(ref);
+        auto k = elements.find_block(e);
+        auto s = SideTable::local_side(ref);
+        return std::make_tuple(e, k, s, sl[k].sides[s]);
+    };
+    for (auto ref : bnd) {
+        auto [e, k, s, side] = locate(ref);
+        counts[slot[k][side.num_nodes]]++;
+    }
+    for (std::size_t j = 0; j < result.size(); j++) {
+        auto & bs = result[j];
+        bs.block.element_tags.reserve(counts[j]);
+        bs.block.connectivity.reserve(counts[j] * element_info(bs.block.element_type).num_nodes);
+        bs.parents.reserve(counts[j]);
+        bs.local_sides.reserve(counts[j]);
+    }
+    std::size_t tag = 1;
+    for (auto ref : bnd) {
+        auto [e, k, s, side] = locate(ref);
+        auto & bs = result[slot[k][side.num_nodes]];
+        auto conn = elements.block(k).get_node_tags(e - elements.offset(k));
+        bs.block.element_tags.push_back(tag++);
+        for (int j = 0; j < side.num_nodes; j++)
+            bs.block.connectivity.push_back(conn[side.nodes[j]]);
+        bs.parents.push_back(e);
+        bs.local_sides.push_back(s);
+    }
+    // drop side types that did not make it to the boundary
+    result.erase(std::remove_if(result.begin(),
+                                result.end(),
+                                [](const BoundarySides & bs) { return bs.parents.empty(); }),
+                 result.end());
+    return result;
+}
+
+} // namespace gmshparsercpp
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ZstdStreamBuf.h"
+#include "gmshparsercpp/Exception.h"
+
+namespace gmshparsercpp {
+
+ZstdStreamBuf::ZstdStreamBuf(std::streambuf * src) :
+    src(src),
+    dctx(ZSTD_createDCtx()),
+    in_buf(ZSTD_DStreamInSize()),
+    out_buf(ZSTD_DStreamOutSize()),
+    input({ this->in_buf.data(), 0, 0 }),
+    src_eof(false),
+    last_ret(0)
+{
+    if (this->dctx == nullptr)
+        throw Exception("Failed to initialize zstd decompression context.");
+    setg(this->out_buf.data(), this->out_buf.data(), this->out_buf.data());
+}
+
+ZstdStreamBuf::~ZstdStreamBuf()
+{
+    ZSTD_freeDCtx(this->dctx);
+}
+
+ZstdStreamBuf::int_type
+ZstdStreamBuf::underflow()
+{
+    if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+
+    while (true) {
+        if (this->input.pos == this->input.size && !this->src_eof) {
+            auto n = this->src->sgetn(this->in_buf.data(), this->in_buf.size());
+            if (n <= 0)
+                this->src_eof = true;
+            this->input = { this->in_buf.data(), static_cast<std::size_t>(n > 0 ? n : 0), 0 };
+        }
+        // 0 means the last frame was decoded and flushed completely
+        if (this->input.pos == this->input.size && this->src_eof && this->last_ret == 0)
+            return traits_type::eof();
+
+        ZSTD_outBuffer output = { this->out_buf.data(), this->out_buf.size(), 0 };
+        this->last_ret = ZSTD_decompressStream(this->dctx, &output, &this->input);
+        if (ZSTD_isError(this->last_ret))
+            throw Exception("Failed to decompress data: {}", ZSTD_getErrorName(this->last_ret));
+
+        if (output.pos > 0) {
+            setg(this->out_buf.data(), this->out_buf.data(), this->out_buf.data() + output.pos);
+            return traits_type::to_int_type(*gptr());
+        }
+        if (this->input.pos == this->input.size && this->src_eof && this->last_ret != 0)
+            throw Exception("Unexpected end of compressed data.");
+    }
+}
+
+} // namespace gmshparsercpp
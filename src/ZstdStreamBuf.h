@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <streambuf>
+#include <vector>
+#include <zstd.h>
+
+namespace gmshparsercpp {
+
+/// Stream buffer that decompresses zstd-compressed data read from another stream buffer
+///
+/// Only a bounded amount of compressed and decompressed data is held in memory at any time.
+class ZstdStreamBuf : public std::streambuf {
+public:
+    /// Construct zstd stream buffer
+    ///
+    /// @param src Stream buffer with the compressed data
+    explicit ZstdStreamBuf(std::streambuf * src);
+    ~ZstdStreamBuf() override;
+
+protected:
+    int_type underflow() override;
+
+private:
+    /// Source of the compressed data
+    std::streambuf * src;
+    /// zstd decompression context
+    ZSTD_DCtx * dctx;
+    /// Compressed data
+    std::vector<char> in_buf;
+    /// Decompressed data
+    std::vector<char> out_buf;
+    /// Current position in the compressed data
+    ZSTD_inBuffer input;
+    /// Flag indicating that the source has no more data
+    bool src_eof;
+    /// Last hint returned by the decompressor (0 means a frame was fully decoded)
+    std::size_t last_ret;
+};
+
+} // namespace gmshparsercpp
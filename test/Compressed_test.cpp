@@ -0,0 +1,128 @@
+#include <gmock/gmock.h>
+#include "TestConfig.h"
+#include "ExceptionTestMacros.h"
+#include "MshFileTestUtils.h"
+#include "gmshparsercpp/MshFile.h"
+#include <fstream>
+#include <sstream>
+
+using namespace gmshparsercpp;
+using namespace testing;
+
+#if defined(GMSHPARSERCPP_WITH_ZLIB) || defined(GMSHPARSERCPP_WITH_ZSTD)
+
+namespace {
+
+void
+expect_same_as_uncompressed(const std::string & name, const std::string & ext)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + "/" + name;
+    MshFile plain(file_name);
+    plain.parse();
+
+    MshFile compressed(file_name + ext);
+    EXPECT_NO_THROW({ compressed.parse(); });
+    expect_same_mesh(compressed, plain);
+
+    MshFile read_ahead(file_name + ext);
+    read_ahead.set_read_ahead(64);
+    EXPECT_NO_THROW({ read_ahead.parse(); });
+    expect_same_mesh(read_ahead, plain);
+}
+
+void
+expect_truncated_input_error(const std::string & name)
+{
+    std::ifstream file(std::string(GMSHPARSERCPP_ASSETS_DIR) + "/" + name, std::ios::binary);
+    std::stringstream ss;
+    ss << file.rdbuf();
+    auto data = ss.str();
+    for (std::size_t block_size : { 0, 64 }) {
+        EXPECT_THROW_MSG(
+            {
+                MshFile f(data.data(), data.size() / 2);
+                f.set_read_ahead(block_size);
+                f.parse();
+            },
+            "Unexpected end of compressed data.");
+    }
+}
+
+} // namespace
+
+#endif
+
+#ifdef GMSHPARSERCPP_WITH_ZLIB
+
+TEST(CompressedTest, gzip_asc)
+{
+    expect_same_as_uncompressed("quad-v4.asc.msh", ".gz");
+}
+
+TEST(CompressedTest, gzip_bin)
+{
+    expect_same_as_uncompressed("prism-v4.bin.msh", ".gz");
+}
+
+TEST(CompressedTest, gzip_truncated)
+{
+    expect_truncated_input_error("prism-v4.bin.msh.gz");
+}
+
+#else
+
+TEST(CompressedTest, gzip_unsupported)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + "/quad-v4.asc.msh.gz";
+    EXPECT_THAT_THROW_MSG({ MshFile f(file_name); },
+                          HasSubstr("was built without zlib support"));
+}
+
+#endif
+
+#ifdef GMSHPARSERCPP_WITH_ZSTD
+
+TEST(CompressedTest, zstd_asc)
+{
+    expect_same_as_uncompressed("quad-v4.asc.msh", ".zst");
+}
+
+TEST(CompressedTest, zstd_bin)
+{
+    expect_same_as_uncompressed("prism-v4.bin.msh", ".zst");
+}
+
+TEST(CompressedTest, zstd_end_of_input)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + "/quad-v4.asc.msh";
+    MshFile plain(file_name);
+    plain.parse();
+
+    std::ifstream file(file_name + ".zst", std::ios::binary);
+    std::stringstream ss;
+    ss << file.rdbuf();
+    auto data = ss.str();
+    // the input ends right after the last frame; reaching it must not look like truncated data
+    for (std::size_t block_size : { 0, 1, 64 }) {
+        MshFile f(data.data(), data.size());
+        f.set_read_ahead(block_size);
+        EXPECT_NO_THROW({ f.parse(); });
+        expect_same_mesh(f, plain);
+    }
+}
+
+TEST(CompressedTest, zstd_truncated)
+{
+    expect_truncated_input_error("prism-v4.bin.msh.zst");
+}
+
+#else
+
+TEST(CompressedTest, zstd_unsupported)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + "/quad-v4.asc.msh.zst";
+    EXPECT_THAT_THROW_MSG({ MshFile f(file_name); },
+                          HasSubstr("was built without zstd support"));
+}
+
+#endif
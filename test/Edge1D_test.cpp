@@ -63,10 +63,10 @@ TEST(Edge1DTest, single_block)
         { { 3, 4 } }, { { 4, 1 } }, { { 2, 5, 1 }, { 1, 5, 4 }, { 3, 5, 2 }, { 4, 5, 3 } },
     };
     for (int i = 0; i < el_blks.size(); i++) {
-        EXPECT_EQ(el_blks[i].elements.size(), conn[i].size());
-        for (int j = 0; j < el_blks[i].elements.size(); j++) {
-            for (int k = 0; k < el_blks[i].elements[j].node_tags.size(); k++)
-                EXPECT_EQ(el_blks[i].elements[j].node_tags[k], conn[i][j][k]);
+        EXPECT_EQ(el_blks[i].size(), conn[i].size());
+        for (int j = 0; j < el_blks[i].size(); j++) {
+            for (int k = 0; k < conn[i][j].size(); k++)
+                EXPECT_EQ(el_blks[i].get_node_tags(j)[k], conn[i][j][k]);
         }
     }
 #endif
@@ -107,10 +107,10 @@ TEST(Edge1DTest, single_block)
     EXPECT_EQ(el_blks.size(), 3);
 
     for (std::size_t i = 0; i < el_blks.size(); i++) {
-        EXPECT_EQ(el_blks[i].elements.size(), conn[i].size());
-        for (std::size_t j = 0; j < el_blks[i].elements.size(); j++) {
-            for (std::size_t k = 0; k < el_blks[i].elements[j].node_tags.size(); k++)
-                EXPECT_EQ(el_blks[i].elements[j].node_tags[k], conn[i][j][k]);
+        EXPECT_EQ(el_blks[i].size(), conn[i].size());
+        for (std::size_t j = 0; j < el_blks[i].size(); j++) {
+            for (std::size_t k = 0; k < conn[i][j].size(); k++)
+                EXPECT_EQ(el_blks[i].get_node_tags(j)[k], conn[i][j][k]);
         }
     }
 }
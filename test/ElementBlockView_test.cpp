@@ -0,0 +1,66 @@
+#include <gmock/gmock.h>
+#include "TestConfig.h"
+#include "ExceptionTestMacros.h"
+#include "gmshparsercpp/ElementBlockView.h"
+
+using namespace gmshparsercpp;
+using namespace testing;
+
+TEST(ElementBlockViewTest, view)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + std::string("/quad-v4.asc.msh");
+    MshFile f(file_name);
+    f.parse();
+
+    auto & blk = f.get_element_blocks()[8];
+    ElementBlockView<TRI3> view(blk);
+    static_assert(decltype(view)::NUM_NODES == 3);
+    static_assert(decltype(view[0])::size() == 3);
+    EXPECT_EQ(&view.get_block(), &blk);
+    ASSERT_EQ(view.size(), 4);
+    EXPECT_EQ(view.tag(0), 9);
+    EXPECT_EQ(view.tag(3), 12);
+    EXPECT_THAT(view[0], ElementsAre(2, 5, 1));
+    EXPECT_THAT(view[3].to_array(), ElementsAre(4, 5, 3));
+    EXPECT_EQ(view[1][2], 4);
+    EXPECT_EQ(view.data(), blk.connectivity.data());
+}
+
+TEST(ElementBlockViewTest, wrong_type)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + std::string("/quad-v4.asc.msh");
+    MshFile f(file_name);
+    f.parse();
+
+    EXPECT_THROW_MSG(ElementBlockView<QUAD4>(f.get_element_blocks()[8]),
+                     "Element block holds 'TRI3' elements, not 'QUAD4'.");
+}
+
+TEST(ElementBlockViewTest, visit)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + std::string("/prism-v4.asc.msh");
+    MshFile f(file_name);
+    f.parse();
+
+    for (auto & blk : f.get_element_blocks()) {
+        auto n = visit_element_block(blk, [&](auto view) {
+            using View = decltype(view);
+            EXPECT_EQ(View::NUM_NODES, blk.get_num_nodes_per_element());
+            EXPECT_EQ(view.size(), blk.size());
+            std::size_t n_tags = 0;
+            for (std::size_t i = 0; i < view.size(); i++)
+                for (auto tag : view[i]) {
+                    EXPECT_EQ(tag, blk.connectivity[n_tags]);
+                    n_tags++;
+                }
+            return n_tags;
+        });
+        EXPECT_EQ(n, blk.connectivity.size());
+    }
+}
+
+TEST(ElementBlockViewTest, visit_unknown)
+{
+    MshFile::ElementBlock blk;
+    EXPECT_THROW_MSG(visit_element_block(blk, [](auto) {}), "Unknown element type 'NONE'");
+}
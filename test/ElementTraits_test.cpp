@@ -0,0 +1,119 @@
+#include <gmock/gmock.h>
+#include "gmshparsercpp/ElementTraits.h"
+#include <iterator>
+
+using namespace gmshparsercpp;
+
+static_assert(ElementTraits<HEX8>::num_nodes == 8);
+static_assert(ElementTraits<HEX8>::dimension == 3);
+static_assert(ElementTraits<HEX8>::family == ElementFamily::HEXAHEDRON);
+static_assert(ElementTraits<TRI6>::order == 2);
+static_assert(ElementTraits<TRI6>::num_corner_nodes == 3);
+static_assert(ElementTraits<POINT>::dimension == 0);
+static_assert(!element_info(NONE).is_valid());
+static_assert(!element_info(static_cast<ElementType>(50)).is_valid());
+static_assert(!element_info(static_cast<ElementType>(1000)).is_valid());
+
+TEST(ElementTraitsTest, table)
+{
+    // gmsh type id, number of nodes, dimension, order, family, number of corner nodes
+    struct Expected {
+        int id;
+        int num_nodes;
+        int dimension;
+        int order;
+        ElementFamily family;
+        int num_corner_nodes;
+    };
+    using F = ElementFamily;
+    const Expected expected[] = {
+        { 1, 2, 1, 1, F::LINE, 2 },           { 2, 3, 2, 1, F::TRIANGLE, 3 },
+        { 3, 4, 2, 1, F::QUADRILATERAL, 4 },  { 4, 4, 3, 1, F::TETRAHEDRON, 4 },
+        { 5, 8, 3, 1, F::HEXAHEDRON, 8 },     { 6, 6, 3, 1, F::PRISM, 6 },
+        { 7, 5, 3, 1, F::PYRAMID, 5 },        { 8, 3, 1, 2, F::LINE, 2 },
+        { 9, 6, 2, 2, F::TRIANGLE, 3 },       { 10, 9, 2, 2, F::QUADRILATERAL, 4 },
+        { 11, 10, 3, 2, F::TETRAHEDRON, 4 },  { 12, 27, 3, 2, F::HEXAHEDRON, 8 },
+        { 13, 18, 3, 2, F::PRISM, 6 },        { 14, 14, 3, 2, F::PYRAMID, 5 },
+        { 15, 1, 0, 0, F::POINT, 1 },         { 16, 8, 2, 2, F::QUADRILATERAL, 4 },
+        { 17, 20, 3, 2, F::HEXAHEDRON, 8 },   { 18, 15, 3, 2, F::PRISM, 6 },
+        { 19, 13, 3, 2, F::PYRAMID, 5 },      { 20, 9, 2, 3, F::TRIANGLE, 3 },
+        { 21, 10, 2, 3, F::TRIANGLE, 3 },     { 22, 12, 2, 4, F::TRIANGLE, 3 },
+        { 23, 15, 2, 4, F::TRIANGLE, 3 },     { 24, 15, 2, 5, F::TRIANGLE, 3 },
+        { 25, 21, 2, 5, F::TRIANGLE, 3 },     { 26, 4, 1, 3, F::LINE, 2 },
+        { 27, 5, 1, 4, F::LINE, 2 },          { 28, 6, 1, 5, F::LINE, 2 },
+        { 29, 20, 3, 3, F::TETRAHEDRON, 4 },  { 30, 35, 3, 4, F::TETRAHEDRON, 4 },
+        { 31, 56, 3, 5, F::TETRAHEDRON, 4 },  { 92, 64, 3, 3, F::HEXAHEDRON, 8 },
+        { 93, 125, 3, 4, F::HEXAHEDRON, 8 },
+    };
+    for (auto & e : expected) {
+        auto & info = element_info(static_cast<ElementType>(e.id));
+        SCOPED_TRACE(e.id);
+        EXPECT_EQ(info.type, e.id);
+        EXPECT_EQ(info.num_nodes, e.num_nodes);
+        EXPECT_EQ(info.dimension, e.dimension);
+        EXPECT_EQ(info.order, e.order);
+        EXPECT_EQ(info.family, e.family);
+        EXPECT_EQ(info.num_corner_nodes, e.num_corner_nodes);
+    }
+
+    int n_valid = 0;
+    for (auto & info : ELEMENT_INFO)
+        n_valid += info.is_valid();
+    EXPECT_EQ(n_valid, std::size(expected));
+}
+
+TEST(ElementTraitsTest, info)
+{
+    auto & info = element_info(PRISM15);
+    EXPECT_EQ(info.type, PRISM15);
+    EXPECT_EQ(info.num_nodes, 15);
+    EXPECT_EQ(info.dimension, 3);
+    EXPECT_EQ(info.order, 2);
+    EXPECT_EQ(info.family, ElementFamily::PRISM);
+    EXPECT_EQ(info.num_corner_nodes, 6);
+}
+
+static_assert(ElementTraits<HEX27>::num_edges == 12);
+static_assert(ElementTraits<HEX27>::num_faces == 6);
+static_assert(ElementTraits<TRI6>::num_faces == 1);
+static_assert(ElementTraits<POINT>::num_edges == 0);
+
+TEST(ElementTraitsTest, reference_topology)
+{
+    for (auto & info : ELEMENT_INFO) {
+        if (!info.is_valid())
+            continue;
+        auto & topo = reference_topology(info.family);
+        // every corner is used by an edge, each edge shared by two faces in 3D
+        std::vector<int> corner_edges(info.num_corner_nodes, 0);
+        for (int i = 0; i < topo.num_edges; i++)
+            for (auto c : topo.edges[i]) {
+                ASSERT_LT(c, info.num_corner_nodes);
+                corner_edges[c]++;
+            }
+        if (info.dimension >= 1) {
+            EXPECT_THAT(corner_edges, testing::Each(testing::Gt(0)));
+        }
+        if (info.dimension == 3) {
+            // Euler characteristic of the boundary
+            EXPECT_EQ(info.num_corner_nodes - topo.num_edges + topo.num_faces, 2);
+            // each edge of a closed surface is used by two faces in opposite directions
+            for (int i = 0; i < topo.num_edges; i++) {
+                int n_fwd = 0;
+                int n_bwd = 0;
+                auto [a, b] = topo.edges[i];
+                for (int f = 0; f < topo.num_faces; f++) {
+                    auto & face = topo.faces[f];
+                    for (int j = 0; j < face.num_nodes; j++) {
+                        auto p = face.nodes[j];
+                        auto q = face.nodes[(j + 1) % face.num_nodes];
+                        n_fwd += p == a && q == b;
+                        n_bwd += p == b && q == a;
+                    }
+                }
+                EXPECT_EQ(n_fwd, 1) << info.type << " edge " << i;
+                EXPECT_EQ(n_bwd, 1) << info.type << " edge " << i;
+            }
+        }
+    }
+}
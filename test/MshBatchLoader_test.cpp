@@ -0,0 +1,92 @@
+#include <gmock/gmock.h>
+#include "TestConfig.h"
+#include "MshFileTestUtils.h"
+#include "gmshparsercpp/MshBatchLoader.h"
+#include <mutex>
+
+using namespace gmshparsercpp;
+using namespace testing;
+
+namespace {
+
+std::vector<std::string>
+asset_files()
+{
+    std::vector<std::string> names;
+    for (auto name : { "/quad-v4.asc.msh",
+                       "/quad-v2.bin.msh",
+                       "/prism-v4.bin.msh",
+                       "/prism-v2.asc.msh",
+                       "/1d.msh",
+                       "/rect-10x10.msh" })
+        names.push_back(std::string(GMSHPARSERCPP_ASSETS_DIR) + name);
+    return names;
+}
+
+} // namespace
+
+TEST(MshBatchLoaderTest, load)
+{
+    auto file_names = asset_files();
+    // every file a few times, so that workers reuse their parser
+    std::vector<std::string> batch;
+    for (int i = 0; i < 4; i++)
+        batch.insert(batch.end(), file_names.begin(), file_names.end());
+
+    std::vector<std::unique_ptr<MshFile>> gold;
+    for (auto & name : file_names) {
+        gold.push_back(std::make_unique<MshFile>(name));
+        gold.back()->parse();
+    }
+
+    std::mutex mutex;
+    std::vector<int> seen(batch.size(), 0);
+    MshBatchLoader loader(3);
+    loader.load(batch, [&](std::size_t idx, MshFile & file) {
+        expect_same_mesh(file, *gold[idx % file_names.size()]);
+        std::lock_guard<std::mutex> lock(mutex);
+        seen[idx]++;
+    });
+    EXPECT_THAT(seen, Each(1));
+}
+
+TEST(MshBatchLoaderTest, setup)
+{
+    auto file_names = asset_files();
+    std::atomic<int> n_setup(0);
+    std::atomic<int> n_stats(0);
+    MshBatchLoader loader(2);
+    loader.set_setup_callback([&](MshFile & file) {
+        n_setup++;
+        file.set_collect_stats(true);
+    });
+    loader.load(file_names, [&](std::size_t, MshFile & file) {
+        if (!file.get_stats().sections.empty())
+            n_stats++;
+    });
+    EXPECT_EQ(n_setup, 2);
+    EXPECT_EQ(n_stats, file_names.size());
+}
+
+TEST(MshBatchLoaderTest, empty)
+{
+    MshBatchLoader loader;
+    int n = 0;
+    loader.load({}, [&](std::size_t, MshFile &) { n++; });
+    EXPECT_EQ(n, 0);
+}
+
+TEST(MshBatchLoaderTest, error)
+{
+    auto file_names = asset_files();
+    auto bad = std::string(GMSHPARSERCPP_ASSETS_DIR) + "/unsupported-version.msh";
+    file_names.insert(file_names.begin() + 2, bad);
+    MshBatchLoader loader(2);
+    try {
+        loader.load(file_names, [](std::size_t, MshFile &) {});
+        FAIL();
+    }
+    catch (Exception & e) {
+        EXPECT_THAT(e.what(), HasSubstr("Failed to load '" + bad + "'"));
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <gmock/gmock.h>
+#include "gmshparsercpp/MshFile.h"
+
+/// Check that two parsed MSH files hold the same mesh
+inline void
+expect_same_mesh(const gmshparsercpp::MshFile & a, const gmshparsercpp::MshFile & b)
+{
+    EXPECT_EQ(a.get_version(), b.get_version());
+    EXPECT_EQ(a.is_ascii(), b.is_ascii());
+
+    auto & a_names = a.get_physical_names();
+    auto & b_names = b.get_physical_names();
+    ASSERT_EQ(a_names.size(), b_names.size());
+    for (std::size_t i = 0; i < a_names.size(); i++) {
+        EXPECT_EQ(a_names[i].dimension, b_names[i].dimension);
+        EXPECT_EQ(a_names[i].tag, b_names[i].tag);
+        EXPECT_EQ(a_names[i].name, b_names[i].name);
+    }
+
+    auto & a_nodes = a.get_nodes();
+    auto & b_nodes = b.get_nodes();
+    ASSERT_EQ(a_nodes.size(), b_nodes.size());
+    for (std::size_t i = 0; i < a_nodes.size(); i++) {
+        EXPECT_EQ(a_nodes[i].dimension, b_nodes[i].dimension);
+        EXPECT_EQ(a_nodes[i].entity_tag, b_nodes[i].entity_tag);
+        EXPECT_THAT(a_nodes[i].tags, testing::ElementsAreArray(b_nodes[i].tags));
+        ASSERT_EQ(a_nodes[i].coordinates.size(), b_nodes[i].coordinates.size());
+        for (std::size_t j = 0; j < a_nodes[i].coordinates.size(); j++) {
+            EXPECT_DOUBLE_EQ(a_nodes[i].coordinates[j].x, b_nodes[i].coordinates[j].x);
+            EXPECT_DOUBLE_EQ(a_nodes[i].coordinates[j].y, b_nodes[i].coordinates[j].y);
+            EXPECT_DOUBLE_EQ(a_nodes[i].coordinates[j].z, b_nodes[i].coordinates[j].z);
+        }
+    }
+
+    auto & a_blks = a.get_element_blocks();
+    auto & b_blks = b.get_element_blocks();
+    ASSERT_EQ(a_blks.size(), b_blks.size());
+    for (std::size_t i = 0; i < a_blks.size(); i++) {
+        EXPECT_EQ(a_blks[i].dimension, b_blks[i].dimension);
+        EXPECT_EQ(a_blks[i].tag, b_blks[i].tag);
+        EXPECT_EQ(a_blks[i].element_type, b_blks[i].element_type);
+        EXPECT_THAT(a_blks[i].element_tags, testing::ElementsAreArray(b_blks[i].element_tags));
+        EXPECT_THAT(a_blks[i].connectivity, testing::ElementsAreArray(b_blks[i].connectivity));
+    }
+}
@@ -1,11 +1,119 @@
 #include <gmock/gmock.h>
 #include "TestConfig.h"
 #include "ExceptionTestMacros.h"
+#include "MshFileTestUtils.h"
 #include "gmshparsercpp/MshFile.h"
+#ifdef GMSHPARSERCPP_COUNT_ALLOCATIONS
+    #include "AllocationCounter.h"
+#endif
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <sstream>
 
 using namespace gmshparsercpp;
 using namespace testing;
 
+namespace {
+
+/// Resource the parsed data of file `f` constructed with `resource` is allocated from
+std::pmr::memory_resource *
+data_resource([[maybe_unused]] const MshFile & f, std::pmr::memory_resource * resource)
+{
+#ifdef GMSHPARSERCPP_COUNT_ALLOCATIONS
+    // a counting resource of `f` sits on top of `resource`
+    EXPECT_NE(f.get_memory_resource(), resource);
+    return f.get_memory_resource();
+#else
+    return resource;
+#endif
+}
+
+std::string
+read_file(const std::string & file_name)
+{
+    std::ifstream file(file_name, std::ios::binary);
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+}
+
+/// Stream buffer that fails with an exception after handing out `size` bytes of `data`
+class FailingStreamBuf : public std::streambuf {
+public:
+    FailingStreamBuf(const std::string & data, std::size_t size) : data(data.substr(0, size)) {}
+
+    bool done = false;
+
+protected:
+    int_type
+    underflow() override
+    {
+        if (this->done)
+            throw Exception("Read error");
+        auto begin = const_cast<char *>(this->data.data());
+        setg(begin, begin, begin + this->data.size());
+        this->done = true;
+        return traits_type::to_int_type(*begin);
+    }
+
+private:
+    std::string data;
+};
+
+/// Memory resource counting the bytes allocated through it
+class CountingResource : public std::pmr::memory_resource {
+public:
+    /// Number of bytes allocated
+    std::size_t num_bytes = 0;
+    /// Number of bytes allocated and not freed yet
+    std::size_t live_bytes = 0;
+
+private:
+    void *
+    do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        this->num_bytes += bytes;
+        this->live_bytes += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void
+    do_deallocate(void * p, std::size_t bytes, std::size_t alignment) override
+    {
+        this->live_bytes -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool
+    do_is_equal(const std::pmr::memory_resource & other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+/// Parse a file with all parsed data going into `resource`
+///
+/// The default resource is disabled meanwhile, so any container missing `resource` throws.
+void
+parse_with_resource(MshFile & f)
+{
+    auto prev = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    try {
+        f.parse();
+    }
+    catch (...) {
+        std::pmr::set_default_resource(prev);
+        throw;
+    }
+    std::pmr::set_default_resource(prev);
+}
+
+} // namespace
+
 TEST(MshFileTest, empty)
 {
     EXPECT_THROW_MSG(
@@ -211,3 +319,775 @@ TEST(MshFileTest, num_element_nodes)
 
     EXPECT_THROW_MSG(MshFile::get_nodes_per_element(NONE), "Unknown element type 'NONE'");
 }
+
+TEST(MshFileTest, from_stream)
+{
+    for (auto name : { "/quad-v4.asc.msh", "/quad-v2.bin.msh", "/prism-v4.bin.msh" }) {
+        std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + name;
+        MshFile gold(file_name);
+        gold.parse();
+
+        std::istringstream stream(read_file(file_name));
+        MshFile f(stream);
+        EXPECT_NO_THROW({ f.parse(); });
+        expect_same_mesh(f, gold);
+    }
+}
+
+TEST(MshFileTest, from_memory)
+{
+    for (auto name : { "/quad-v4.asc.msh", "/quad-v2.bin.msh", "/prism-v4.bin.msh" }) {
+        std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + name;
+        MshFile gold(file_name);
+        gold.parse();
+
+        auto data = read_file(file_name);
+        MshFile f(data.data(), data.size());
+        EXPECT_NO_THROW({ f.parse(); });
+        expect_same_mesh(f, gold);
+    }
+}
+
+TEST(MshFileTest, read_ahead)
+{
+    for (auto name : { "/quad-v4.asc.msh", "/quad-v2.bin.msh", "/prism-v4.bin.msh" }) {
+        std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + name;
+        MshFile gold(file_name);
+        gold.parse();
+
+        for (std::size_t num_blocks : { 1, 2, 3 }) {
+            // tiny blocks, so that tokens and binary values straddle block boundaries
+            MshFile f(file_name);
+            f.set_read_ahead(7, num_blocks);
+            EXPECT_NO_THROW({ f.parse(); });
+            expect_same_mesh(f, gold);
+        }
+    }
+}
+
+TEST(MshFileTest, read_ahead_error)
+{
+    auto data = read_file(std::string(GMSHPARSERCPP_ASSETS_DIR) + "/quad-v4.asc.msh");
+    for (std::size_t num_blocks : { 1, 2 }) {
+        // the source fails on the background thread partway through the file
+        FailingStreamBuf buf(data, data.size() / 2);
+        std::istream stream(&buf);
+        auto f = std::make_unique<MshFile>(stream);
+        f->set_read_ahead(64, num_blocks);
+        EXPECT_THROW_MSG(f->parse(), "Read error");
+        EXPECT_TRUE(buf.done);
+        // the background thread stopped on the error and is joined
+        EXPECT_NO_THROW(f.reset());
+    }
+
+    // a file that failed can be reused
+    FailingStreamBuf buf(data, data.size() / 2);
+    std::istream stream(&buf);
+    MshFile f(stream);
+    f.set_read_ahead(64);
+    EXPECT_THROW_MSG(f.parse(), "Read error");
+    f.open(data.data(), data.size());
+    EXPECT_NO_THROW(f.parse());
+    EXPECT_EQ(f.get_version(), 4.1);
+}
+
+TEST(MshFileTest, parallel_decode)
+{
+    for (auto name : { "/quad-v4.bin.msh", "/prism-v4.bin.msh", "/quad-v4.asc.msh" }) {
+        std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + name;
+        MshFile gold(file_name);
+        gold.parse();
+
+        for (unsigned int n_threads : { 0, 2, 4 }) {
+            MshFile f(file_name);
+            f.set_num_threads(n_threads);
+            f.set_read_ahead(64);
+            EXPECT_NO_THROW({ f.parse(); });
+            expect_same_mesh(f, gold);
+        }
+    }
+}
+
+TEST(MshFileTest, parallel_decode_truncated)
+{
+    auto data = read_file(std::string(GMSHPARSERCPP_ASSETS_DIR) + "/prism-v4.bin.msh");
+    auto pos = data.find("$Elements");
+    ASSERT_NE(pos, std::string::npos);
+    MshFile f(data.data(), pos + 100);
+    f.set_num_threads(2);
+    EXPECT_THROW_MSG(f.parse(), "Reached end of file");
+}
+
+TEST(MshFileTest, v2_bin_element_group)
+{
+    // two LINE2 elements sharing one element header
+    std::string data = "$MeshFormat\n2.2 1 8\n";
+    auto add = [&](int val) { data.append(reinterpret_cast<const char *>(&val), sizeof(val)); };
+    add(1);
+    data += "\n$EndMeshFormat\n$Elements\n2\n";
+    for (int val : { int(LINE2), 2, 2, 1, 10, 1, 1, 2, 2, 10, 1, 2, 3 })
+        add(val);
+    data += "\n$EndElements\n";
+
+    MshFile f(data.data(), data.size());
+    EXPECT_NO_THROW({ f.parse(); });
+    auto & el_blks = f.get_element_blocks();
+    ASSERT_EQ(el_blks.size(), 1);
+    EXPECT_EQ(el_blks[0].tag, 10);
+    EXPECT_EQ(el_blks[0].element_type, LINE2);
+    ASSERT_EQ(el_blks[0].size(), 2);
+    EXPECT_THAT(el_blks[0].connectivity, ElementsAre(1, 2, 2, 3));
+}
+
+TEST(MshFileTest, v4_asc_node_batches)
+{
+    // more nodes than are decoded in one batch, with parametric coordinates
+    const std::size_t n = 600;
+    std::string data = "$MeshFormat\n4.1 0 8\n$EndMeshFormat\n$Nodes\n1 600 1 600\n2 1 1 600\n";
+    for (std::size_t i = 1; i <= n; i++)
+        data += std::to_string(i) + "\n";
+    char row[128];
+    for (std::size_t i = 0; i < n; i++) {
+        std::snprintf(row, sizeof(row), "%.17g %.17g %.17g %.17g %.17g\n", i * 0.5, -1. * i,
+                      1e-3 * i, i + 0.25, i + 0.75);
+        data += row;
+    }
+    data += "$EndNodes\n";
+
+    MshFile f(data.data(), data.size());
+    EXPECT_NO_THROW({ f.parse(); });
+    auto & nodes = f.get_nodes();
+    ASSERT_EQ(nodes.size(), 1);
+    ASSERT_EQ(nodes[0].coordinates.size(), n);
+    ASSERT_EQ(nodes[0].get_num_par_coords(), 2);
+    ASSERT_EQ(nodes[0].par_coords.size(), 2 * n);
+    for (std::size_t i = 0; i < n; i++) {
+        EXPECT_EQ(nodes[0].tags[i], i + 1);
+        EXPECT_DOUBLE_EQ(nodes[0].coordinates[i].x, i * 0.5);
+        EXPECT_DOUBLE_EQ(nodes[0].coordinates[i].y, -1. * i);
+        EXPECT_DOUBLE_EQ(nodes[0].coordinates[i].z, 1e-3 * i);
+        EXPECT_DOUBLE_EQ(nodes[0].get_par_coords(i)[0], i + 0.25);
+        EXPECT_DOUBLE_EQ(nodes[0].get_par_coords(i)[1], i + 0.75);
+    }
+}
+
+TEST(MshFileTest, single_precision)
+{
+    for (auto name : { "/quad-v2.asc.msh",
+                       "/quad-v2.bin.msh",
+                       "/quad-v4.asc.msh",
+                       "/prism-v4.asc.msh",
+                       "/prism-v4.bin.msh" }) {
+        std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + name;
+        MshFile gold(file_name);
+        gold.parse();
+
+        for (unsigned int n_threads : { 1, 2 }) {
+            MshFile f(file_name);
+            f.set_num_threads(n_threads);
+            f.set_coordinate_precision(MshFile::Precision::SINGLE);
+            EXPECT_NO_THROW({ f.parse(); });
+            auto & nodes = f.get_nodes();
+            auto & gold_nodes = gold.get_nodes();
+            ASSERT_EQ(nodes.size(), gold_nodes.size());
+            for (std::size_t i = 0; i < nodes.size(); i++) {
+                EXPECT_TRUE(nodes[i].coordinates.empty());
+                EXPECT_THAT(nodes[i].tags, ElementsAreArray(gold_nodes[i].tags));
+                ASSERT_EQ(nodes[i].float_coordinates.size(), gold_nodes[i].coordinates.size());
+                for (std::size_t j = 0; j < nodes[i].float_coordinates.size(); j++) {
+                    auto & pt = nodes[i].float_coordinates[j];
+                    auto & gold_pt = gold_nodes[i].coordinates[j];
+                    EXPECT_EQ(pt.x, float(gold_pt.x));
+                    EXPECT_EQ(pt.y, float(gold_pt.y));
+                    EXPECT_EQ(pt.z, float(gold_pt.z));
+                }
+            }
+            EXPECT_EQ(f.memory_usage().coordinates.size * 2,
+                      gold.memory_usage().coordinates.size);
+        }
+    }
+}
+
+TEST(MshFileTest, single_precision_parametric)
+{
+    std::string data = "$MeshFormat\n4.1 0 8\n$EndMeshFormat\n$Nodes\n1 2 1 2\n2 1 1 2\n1\n2\n"
+                       "0.1 0.2 0.3 0.4 0.5\n1.1 1.2 1.3 1.4 1.5\n$EndNodes\n";
+    MshFile f(data.data(), data.size());
+    f.set_coordinate_precision(MshFile::Precision::SINGLE);
+    EXPECT_NO_THROW({ f.parse(); });
+    auto & node = f.get_nodes()[0];
+    EXPECT_TRUE(node.par_coords.empty());
+    EXPECT_EQ(node.float_coordinates[1].z, 1.3f);
+    EXPECT_THAT(node.float_par_coords, ElementsAre(0.4f, 0.5f, 1.4f, 1.5f));
+    EXPECT_EQ(node.get_par_coords(1), nullptr);
+    ASSERT_NE(node.get_float_par_coords(1), nullptr);
+    EXPECT_EQ(node.get_float_par_coords(1)[0], 1.4f);
+    EXPECT_EQ(node.get_float_par_coords(1)[1], 1.5f);
+}
+
+TEST(MshFileTest, par_coords)
+{
+    // binary v4 file with one parametric surface node block
+    std::string data = "$MeshFormat\n4.1 1 8\n";
+    auto add = [&](auto val) { data.append(reinterpret_cast<const char *>(&val), sizeof(val)); };
+    add(int(1));
+    data += "\n$EndMeshFormat\n$Nodes\n";
+    for (std::size_t val : { 1, 3, 1, 3 })
+        add(val);
+    for (int val : { 2, 1, 1 })
+        add(val);
+    add(std::size_t(3));
+    for (std::size_t val : { 1, 2, 3 })
+        add(val);
+    for (int i = 0; i < 3; i++)
+        for (double val : { 1. * i, 2. * i, 3. * i, 0.5 + i, 0.25 + i })
+            add(val);
+    data += "\n$EndNodes\n";
+
+    for (unsigned int n_threads : { 1, 2 }) {
+        MshFile f(data.data(), data.size());
+        f.set_num_threads(n_threads);
+        EXPECT_NO_THROW({ f.parse(); });
+        auto & node = f.get_nodes()[0];
+        ASSERT_EQ(node.get_num_par_coords(), 2);
+        EXPECT_THAT(node.par_coords, ElementsAre(0.5, 0.25, 1.5, 1.25, 2.5, 2.25));
+        EXPECT_EQ(node.get_par_coords(2)[1], 2.25);
+        EXPECT_EQ(node.get_float_par_coords(2), nullptr);
+        EXPECT_EQ(node.coordinates[2].z, 6.);
+    }
+
+    for (unsigned int n_threads : { 1, 2 }) {
+        MshFile f(data.data(), data.size());
+        f.set_num_threads(n_threads);
+        f.set_read_par_coords(false);
+        EXPECT_NO_THROW({ f.parse(); });
+        auto & node = f.get_nodes()[0];
+        EXPECT_TRUE(node.parametric);
+        EXPECT_TRUE(node.par_coords.empty());
+        EXPECT_EQ(node.get_par_coords(0), nullptr);
+        EXPECT_EQ(node.get_float_par_coords(0), nullptr);
+        ASSERT_EQ(node.coordinates.size(), 3);
+        EXPECT_EQ(node.coordinates[2].y, 4.);
+    }
+}
+
+TEST(MshFileTest, corrupt_block_size)
+{
+    // binary v4 files whose headers announce much more data than there is
+    auto make_file = [](const std::string & section,
+                        std::size_t n_blocks,
+                        std::vector<int> header,
+                        std::size_t n) {
+        std::string data = "$MeshFormat\n4.1 1 8\n";
+        auto add = [&](auto val) {
+            data.append(reinterpret_cast<const char *>(&val), sizeof(val));
+        };
+        add(int(1));
+        data += "\n$EndMeshFormat\n$" + section + "\n";
+        for (std::size_t val : { n_blocks, n, std::size_t(1), n })
+            add(val);
+        for (int val : header)
+            add(val);
+        add(n);
+        for (std::size_t val : { 1, 2, 3 })
+            add(val);
+        data += "\n$End" + section + "\n";
+        return data;
+    };
+    std::vector<std::string> files = {
+        make_file("Nodes", 1, { 2, 1, 0 }, std::size_t(1) << 40),
+        make_file("Elements", 1, { 2, 1, TRI3 }, std::size_t(1) << 40),
+        // block count far beyond the input
+        make_file("Nodes", std::size_t(1) << 60, { 2, 1, 0 }, 1),
+        make_file("Elements", std::size_t(1) << 60, { 2, 1, TRI3 }, 1),
+    };
+    for (auto & data : files)
+        for (unsigned int n_threads : { 1, 2 }) {
+            MshFile f(data.data(), data.size());
+            f.set_num_threads(n_threads);
+            EXPECT_THROW_MSG(f.parse(), "Reached end of file");
+        }
+
+    // payload size does not fit into `std::size_t`
+    auto data = make_file("Elements", 1, { 2, 1, TRI3 }, std::size_t(1) << 62);
+    MshFile f(data.data(), data.size());
+    f.set_num_threads(2);
+    EXPECT_THROW_MSG(f.parse(), "Corrupt block size: 4611686018427387904 rows of 32 bytes overflow");
+}
+
+TEST(MshFileTest, stats)
+{
+    std::string file_name =
+        std::string(GMSHPARSERCPP_ASSETS_DIR) + std::string("/nodal-scalar-dataset.msh");
+    MshFile f(file_name);
+    f.set_collect_stats(true);
+    f.parse();
+
+    auto & stats = f.get_stats();
+    EXPECT_EQ(stats.num_bytes, 284);
+    EXPECT_GE(stats.time, 0.);
+    ASSERT_EQ(stats.sections.size(), 4);
+    std::vector<std::string> names = { "$MeshFormat", "$Nodes", "$Elements", "$NodeData" };
+    std::vector<bool> skipped = { false, false, false, true };
+    std::size_t num_bytes = 0;
+    for (std::size_t i = 0; i < stats.sections.size(); i++) {
+        EXPECT_EQ(stats.sections[i].name, names[i]);
+        EXPECT_EQ(stats.sections[i].skipped, skipped[i]);
+        EXPECT_GT(stats.sections[i].num_bytes, 0);
+        EXPECT_GT(stats.sections[i].num_tokens, 0);
+        num_bytes += stats.sections[i].num_bytes;
+    }
+    EXPECT_LE(num_bytes, stats.num_bytes);
+    // section header, block header and 6 nodes with a tag and 3 coordinates
+    EXPECT_EQ(stats.sections[1].num_values, 4 + 4 + 6 * 4);
+    EXPECT_EQ(stats.sections[3].num_values, 0);
+}
+
+TEST(MshFileTest, stats_disabled)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + std::string("/quad-v4.asc.msh");
+    MshFile f(file_name);
+    f.parse();
+    EXPECT_EQ(f.get_stats().sections.size(), 0);
+    EXPECT_EQ(f.get_stats().num_bytes, 0);
+}
+
+TEST(MshFileTest, stats_parallel_decode)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + std::string("/prism-v4.bin.msh");
+    MshFile serial(file_name);
+    serial.set_collect_stats(true);
+    serial.parse();
+    MshFile parallel(file_name);
+    parallel.set_collect_stats(true);
+    parallel.set_num_threads(2);
+    parallel.parse();
+
+    auto & s_stats = serial.get_stats();
+    auto & p_stats = parallel.get_stats();
+    EXPECT_EQ(s_stats.num_bytes, p_stats.num_bytes);
+    ASSERT_EQ(s_stats.sections.size(), p_stats.sections.size());
+    for (std::size_t i = 0; i < s_stats.sections.size(); i++) {
+        EXPECT_EQ(s_stats.sections[i].num_bytes, p_stats.sections[i].num_bytes);
+        EXPECT_EQ(s_stats.sections[i].num_values, p_stats.sections[i].num_values);
+    }
+}
+
+TEST(MshFileTest, progress)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + std::string("/prism-v4.asc.msh");
+    auto file_size = read_file(file_name).size();
+    MshFile f(file_name);
+    std::vector<std::size_t> reported;
+    f.set_progress_callback(
+        [&](std::size_t num_bytes, std::size_t total_bytes) {
+            EXPECT_EQ(total_bytes, file_size);
+            reported.push_back(num_bytes);
+            return true;
+        },
+        100);
+    f.parse();
+
+    ASSERT_GT(reported.size(), 2);
+    EXPECT_TRUE(std::is_sorted(reported.begin(), reported.end()));
+    EXPECT_EQ(reported.back(), file_size);
+}
+
+TEST(MshFileTest, progress_unknown_size)
+{
+    std::istringstream stream(
+        read_file(std::string(GMSHPARSERCPP_ASSETS_DIR) + std::string("/quad-v4.asc.msh")));
+    MshFile f(stream);
+    std::size_t total = 1;
+    f.set_progress_callback([&](std::size_t, std::size_t total_bytes) {
+        total = total_bytes;
+        return true;
+    });
+    f.parse();
+    EXPECT_EQ(total, 0);
+}
+
+TEST(MshFileTest, cancel_from_callback)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + std::string("/prism-v4.asc.msh");
+    MshFile f(file_name);
+    std::size_t calls = 0;
+    f.set_progress_callback(
+        [&](std::size_t, std::size_t) {
+            calls++;
+            return calls < 3;
+        },
+        100);
+    EXPECT_THROW(f.parse(), CancelledException);
+    EXPECT_EQ(calls, 3);
+}
+
+TEST(MshFileTest, cancel_after_end)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + std::string("/quad-v4.asc.msh");
+    MshFile f(file_name);
+    std::size_t calls = 0;
+    // the file is smaller than the interval, so the only call is the final one
+    f.set_progress_callback([&](std::size_t, std::size_t) {
+        calls++;
+        return false;
+    });
+    EXPECT_NO_THROW(f.parse());
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(f.get_nodes().size(), 9);
+}
+
+
+TEST(MshFileTest, cancel_in_final_callback)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + std::string("/quad-v4.asc.msh");
+    MshFile f(file_name);
+    std::size_t calls = 0;
+    // the file is smaller than the interval, so the only call is the final one
+    f.set_progress_callback([&](std::size_t num_bytes, std::size_t total_bytes) {
+        calls++;
+        EXPECT_EQ(num_bytes, total_bytes);
+        f.cancel();
+        return true;
+    });
+    EXPECT_NO_THROW(f.parse());
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(f.get_nodes().size(), 9);
+    EXPECT_EQ(f.get_element_blocks().size(), 9);
+}
+
+TEST(MshFileTest, cancel)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + std::string("/prism-v4.bin.msh");
+    MshFile f(file_name);
+    f.set_num_threads(2);
+    f.cancel();
+    EXPECT_THROW_MSG(f.parse(), "Parsing was cancelled.");
+}
+
+TEST(MshFileTest, memory_usage)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + std::string("/quad-v4.asc.msh");
+    MshFile f(file_name);
+    EXPECT_EQ(f.memory_usage().total().capacity, 0);
+    f.parse();
+
+    auto mu = f.memory_usage();
+    EXPECT_EQ(mu.nodes.size, 9 * sizeof(MshFile::Node));
+    EXPECT_EQ(mu.node_tags.size, 5 * sizeof(int));
+    EXPECT_EQ(mu.coordinates.size, 5 * sizeof(MshFile::Point));
+    EXPECT_EQ(mu.par_coords.size, 0);
+    EXPECT_EQ(mu.element_blocks.size, 9 * sizeof(MshFile::ElementBlock));
+    ASSERT_EQ(mu.blocks.size(), 9);
+    EXPECT_EQ(mu.blocks[0].element_tags.size, sizeof(int));
+    EXPECT_EQ(mu.blocks[0].connectivity.size, sizeof(int));
+    EXPECT_EQ(mu.blocks[8].element_tags.size, 4 * sizeof(int));
+    EXPECT_EQ(mu.blocks[8].connectivity.size, 12 * sizeof(int));
+    EXPECT_GT(mu.entities.size, 0);
+    EXPECT_GE(mu.names.size, 4 * sizeof(MshFile::PhysicalName));
+
+    auto total = mu.total();
+    EXPECT_GE(total.capacity, total.size);
+    EXPECT_GT(total.size, mu.nodes.size + mu.element_blocks.size);
+}
+
+TEST(MshFileTest, memory_usage_spare)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + std::string("/quad-v4.asc.msh");
+    MshFile f(file_name);
+    f.parse();
+    auto parsed = f.memory_usage();
+    EXPECT_EQ(parsed.spare_nodes.capacity, 0);
+    EXPECT_EQ(parsed.spare_element_blocks.capacity, 0);
+
+    // blocks kept for the next file still hold their buffers
+    f.reset();
+    auto mu = f.memory_usage();
+    EXPECT_EQ(mu.nodes.size, 0);
+    EXPECT_EQ(mu.spare_nodes.size, 9 * sizeof(MshFile::Node));
+    EXPECT_GE(mu.spare_nodes.capacity,
+              mu.spare_nodes.size + parsed.node_tags.capacity + parsed.coordinates.capacity);
+    EXPECT_EQ(mu.spare_element_blocks.size, 9 * sizeof(MshFile::ElementBlock));
+    EXPECT_GE(mu.spare_element_blocks.capacity,
+              mu.spare_element_blocks.size + (5 + 16) * sizeof(int));
+    EXPECT_GE(mu.total().capacity, mu.spare_nodes.capacity + mu.spare_element_blocks.capacity);
+
+    f.release_spare();
+    mu = f.memory_usage();
+    EXPECT_EQ(mu.spare_nodes.capacity, 0);
+    EXPECT_EQ(mu.spare_element_blocks.capacity, 0);
+}
+
+TEST(MshFileTest, stats_allocations)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + std::string("/quad-v4.asc.msh");
+    MshFile f(file_name);
+    f.set_collect_stats(true);
+    f.parse();
+
+    auto & stats = f.get_stats();
+    std::size_t num_allocations = 0;
+    std::size_t allocated_bytes = 0;
+    for (auto & sst : stats.sections) {
+        num_allocations += sst.num_allocations;
+        allocated_bytes += sst.allocated_bytes;
+    }
+#ifdef GMSHPARSERCPP_COUNT_ALLOCATIONS
+    auto nodes = std::find_if(stats.sections.begin(), stats.sections.end(), [](auto & sst) {
+        return sst.name == "$Nodes";
+    });
+    ASSERT_NE(nodes, stats.sections.end());
+    // at least one allocation per node block
+    EXPECT_GE(nodes->num_allocations, 9);
+    EXPECT_GE(nodes->allocated_bytes, 9 * sizeof(MshFile::Node));
+    EXPECT_LE(num_allocations, stats.num_allocations);
+    EXPECT_LE(allocated_bytes, stats.allocated_bytes);
+#else
+    EXPECT_EQ(num_allocations, 0);
+    EXPECT_EQ(allocated_bytes, 0);
+    EXPECT_EQ(stats.num_allocations, 0);
+    EXPECT_EQ(stats.allocated_bytes, 0);
+#endif
+}
+
+TEST(MshFileTest, stats_allocations_names)
+{
+    std::string name(100, 'x');
+    std::string data = "$MeshFormat\n4.1 0 8\n$EndMeshFormat\n$PhysicalNames\n1\n2 1 \"" + name +
+                       "\"\n$EndPhysicalNames\n";
+    MshFile f(data.data(), data.size());
+    f.set_collect_stats(true);
+    f.parse();
+
+    auto & names = f.get_physical_names();
+    ASSERT_EQ(names.size(), 1);
+    EXPECT_EQ(names[0].name, name);
+    auto & sst = f.get_stats().sections[1];
+    EXPECT_EQ(sst.name, "$PhysicalNames");
+#ifdef GMSHPARSERCPP_COUNT_ALLOCATIONS
+    // the name, the vector holding it and the `$EndPhysicalNames` token
+    EXPECT_EQ(sst.num_allocations, 3);
+    EXPECT_GE(sst.allocated_bytes, name.size() + sizeof(MshFile::PhysicalName));
+#else
+    EXPECT_EQ(sst.num_allocations, 0);
+#endif
+}
+
+TEST(MshFileTest, memory_resource)
+{
+    for (auto name : { "/quad-v4.asc.msh", "/prism-v4.bin.msh", "/nodal-scalar-dataset.msh" }) {
+        std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + name;
+        MshFile ref(file_name);
+        ref.parse();
+
+        CountingResource counter;
+        std::pmr::monotonic_buffer_resource arena(&counter);
+        MshFile f(file_name, &arena);
+        EXPECT_EQ(f.get_memory_resource(), data_resource(f, &arena));
+        parse_with_resource(f);
+
+        expect_same_mesh(f, ref);
+        EXPECT_GT(counter.num_bytes, 0);
+        for (auto & node : f.get_nodes()) {
+            EXPECT_EQ(node.tags.get_allocator().resource(), data_resource(f, &arena));
+            EXPECT_EQ(node.coordinates.get_allocator().resource(), data_resource(f, &arena));
+        }
+        for (auto & blk : f.get_element_blocks())
+            EXPECT_EQ(blk.connectivity.get_allocator().resource(), data_resource(f, &arena));
+    }
+}
+
+TEST(MshFileTest, memory_resource_parallel_decode)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + std::string("/prism-v4.bin.msh");
+    MshFile ref(file_name);
+    ref.parse();
+
+    std::pmr::monotonic_buffer_resource arena;
+    MshFile f(file_name, &arena);
+    f.set_num_threads(4);
+    parse_with_resource(f);
+    expect_same_mesh(f, ref);
+}
+
+TEST(MshFileTest, memory_resource_from_memory)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + std::string("/quad-v4.asc.msh");
+    auto data = read_file(file_name);
+    MshFile ref(file_name);
+    ref.parse();
+
+    std::pmr::monotonic_buffer_resource arena;
+    MshFile f(data.data(), data.size(), &arena);
+    parse_with_resource(f);
+    expect_same_mesh(f, ref);
+    EXPECT_EQ(f.get_point_entities()[0].physical_tags.get_allocator().resource(),
+              data_resource(f, &arena));
+}
+
+TEST(MshFileTest, take)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + std::string("/quad-v4.asc.msh");
+    MshFile f(file_name);
+    f.parse();
+
+    auto node_data = f.get_nodes()[0].coordinates.data();
+    auto elem_data = f.get_element_blocks()[8].connectivity.data();
+    auto nodes = f.take_nodes();
+    auto blocks = f.take_element_blocks();
+    EXPECT_EQ(nodes.size(), 9);
+    EXPECT_EQ(blocks.size(), 9);
+    // moved, not copied
+    EXPECT_EQ(nodes[0].coordinates.data(), node_data);
+    EXPECT_EQ(blocks[8].connectivity.data(), elem_data);
+    EXPECT_TRUE(f.get_nodes().empty());
+    EXPECT_TRUE(f.get_element_blocks().empty());
+    EXPECT_EQ(f.get_physical_names().size(), 4);
+
+    auto names = f.take_physical_names();
+    EXPECT_EQ(names.size(), 4);
+    EXPECT_TRUE(f.get_physical_names().empty());
+    EXPECT_TRUE(f.take_nodes().empty());
+}
+
+TEST(MshFileTest, release)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + std::string("/quad-v4.asc.msh");
+    MshFile ref(file_name);
+    ref.parse();
+
+    std::pmr::monotonic_buffer_resource arena;
+    MshFile f(file_name, &arena);
+    f.parse();
+    auto mesh = f.release();
+
+    EXPECT_EQ(mesh.physical_names.size(), ref.get_physical_names().size());
+    EXPECT_EQ(mesh.point_entities.size(), ref.get_point_entities().size());
+    EXPECT_EQ(mesh.curve_entities.size(), ref.get_curve_entities().size());
+    EXPECT_EQ(mesh.surface_entities.size(), ref.get_surface_entities().size());
+    EXPECT_EQ(mesh.volume_entities.size(), ref.get_volume_entities().size());
+    EXPECT_EQ(mesh.nodes.size(), ref.get_nodes().size());
+    EXPECT_EQ(mesh.element_blocks.size(), ref.get_element_blocks().size());
+    EXPECT_EQ(mesh.nodes.get_allocator().resource(), data_resource(f, &arena));
+    EXPECT_EQ(mesh.element_blocks.get_allocator().resource(), data_resource(f, &arena));
+
+    EXPECT_TRUE(f.get_nodes().empty());
+    EXPECT_TRUE(f.get_element_blocks().empty());
+    EXPECT_TRUE(f.get_curve_entities().empty());
+    EXPECT_EQ(f.memory_usage().total().size, 0);
+}
+
+TEST(MshFileTest, release_outlives_file)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + std::string("/quad-v4.asc.msh");
+    std::pmr::monotonic_buffer_resource arena;
+    std::optional<MshFile::Mesh> mesh;
+    std::pmr::memory_resource * resource;
+    {
+        MshFile f(file_name, &arena);
+        f.parse();
+        mesh.emplace(f.release());
+        resource = data_resource(f, &arena);
+    }
+    // data moved out is still usable (and can be freed) once the file is gone
+    ASSERT_EQ(mesh->nodes.size(), 9);
+    EXPECT_EQ(mesh->nodes.get_allocator().resource(), resource);
+    mesh->nodes[0].tags.push_back(100);
+    EXPECT_EQ(mesh->nodes[0].tags.back(), 100);
+    mesh.reset();
+}
+
+TEST(MshFileTest, reopen)
+{
+    std::string quad = std::string(GMSHPARSERCPP_ASSETS_DIR) + std::string("/quad-v4.asc.msh");
+    std::string prism = std::string(GMSHPARSERCPP_ASSETS_DIR) + std::string("/prism-v2.bin.msh");
+    MshFile quad_gold(quad);
+    quad_gold.parse();
+    MshFile prism_gold(prism);
+    prism_gold.parse();
+
+    // freed memory is never handed out again by the arena, so equal buffers mean reused buffers
+    std::pmr::monotonic_buffer_resource arena;
+    MshFile f(&arena);
+    f.set_collect_stats(true);
+    f.open(prism);
+    f.parse();
+    expect_same_mesh(f, prism_gold);
+    auto capacity = f.get_element_blocks().capacity();
+    auto connectivity = f.get_element_blocks()[0].connectivity.data();
+    auto connectivity_capacity = f.get_element_blocks()[0].connectivity.capacity();
+    auto tags = f.get_nodes()[0].tags.data();
+
+    // buffers of the blocks are reused by the blocks of the next file
+    f.open(prism);
+    f.parse();
+    expect_same_mesh(f, prism_gold);
+    EXPECT_EQ(f.get_element_blocks()[0].connectivity.data(), connectivity);
+    EXPECT_EQ(f.get_element_blocks()[0].connectivity.capacity(), connectivity_capacity);
+    EXPECT_EQ(f.get_nodes()[0].tags.data(), tags);
+
+    f.open(quad);
+    EXPECT_TRUE(f.get_element_blocks().empty());
+    EXPECT_EQ(f.get_element_blocks().capacity(), capacity);
+    EXPECT_TRUE(f.get_stats().sections.empty());
+    f.parse();
+    expect_same_mesh(f, quad_gold);
+    EXPECT_EQ(f.get_stats().sections.size(), 6);
+
+    auto data = read_file(prism);
+    f.open(data.data(), data.size());
+    f.parse();
+    expect_same_mesh(f, prism_gold);
+
+    std::ifstream stream(quad, std::ios::binary);
+    f.open(stream);
+    f.parse();
+    expect_same_mesh(f, quad_gold);
+
+    f.reset();
+    EXPECT_TRUE(f.get_nodes().empty());
+    EXPECT_EQ(f.get_version(), 0.);
+}
+
+TEST(MshFileTest, reopen_spare_limit)
+{
+    // v2 files have one node block per node
+    auto make_file = [](std::size_t n) {
+        std::string data =
+            "$MeshFormat\n2.2 0 8\n$EndMeshFormat\n$Nodes\n" + std::to_string(n) + "\n";
+        for (std::size_t i = 1; i <= n; i++)
+            data += std::to_string(i) + " " + std::to_string(i) + " 0 0\n";
+        data += "$EndNodes\n";
+        return data;
+    };
+
+    // memory kept after a reset does not grow with the number of blocks
+    std::size_t kept[2];
+    for (std::size_t k : { 0, 1 }) {
+        auto data = make_file(k == 0 ? 3000 : 6000);
+        CountingResource counter;
+        MshFile f(data.data(), data.size(), &counter);
+        f.parse();
+        auto parsed = counter.live_bytes;
+        f.reset();
+        kept[k] = counter.live_bytes;
+        EXPECT_LT(kept[k], parsed / 2);
+        EXPECT_GE(kept[k], 1024 * (sizeof(int) + sizeof(MshFile::Point)));
+
+        // kept blocks are reused by the next file
+        f.open(data.data(), data.size());
+        f.parse();
+        f.reset();
+        EXPECT_EQ(counter.live_bytes, kept[k]);
+
+        f.release_spare();
+        EXPECT_EQ(counter.live_bytes, 0);
+    }
+    EXPECT_EQ(kept[0], kept[1]);
+}
+
+TEST(MshFileTest, open_non_existent)
+{
+    MshFile f;
+    EXPECT_THROW_MSG(f.open("non-existent.msh"), "Unable to open file 'non-existent.msh'.");
+}
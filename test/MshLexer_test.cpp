@@ -0,0 +1,181 @@
+#include <gmock/gmock.h>
+#include "gmshparsercpp/MshLexer.h"
+#include "ExceptionTestMacros.h"
+#include <cmath>
+#include <sstream>
+#include <streambuf>
+
+using namespace gmshparsercpp;
+
+namespace {
+
+/// Stream buffer handing out its data in small chunks
+class ChunkedStreamBuf : public std::streambuf {
+public:
+    ChunkedStreamBuf(const std::string & data, std::size_t chunk) : data(data), chunk(chunk), pos(0)
+    {
+    }
+
+protected:
+    int_type
+    underflow() override
+    {
+        if (this->pos >= this->data.size())
+            return traits_type::eof();
+        auto begin = const_cast<char *>(this->data.data()) + this->pos;
+        auto n = std::min(this->chunk, this->data.size() - this->pos);
+        setg(begin, begin, begin + n);
+        this->pos += n;
+        return traits_type::to_int_type(*begin);
+    }
+
+private:
+    std::string data;
+    std::size_t chunk;
+    std::size_t pos;
+};
+
+} // namespace
+
+TEST(MshLexerTest, tokens)
+{
+    std::istringstream in("$MeshFormat\n4.1 0 8\n$EndMeshFormat\n\"name with spaces\"\n");
+    MshLexer lexer(&in);
+    auto t = lexer.read();
+    EXPECT_EQ(t.type, MshLexer::Token::Section);
+    EXPECT_EQ(t.str, "$MeshFormat");
+    EXPECT_EQ(lexer.read().as<double>(), 4.1);
+    EXPECT_EQ(lexer.peek().as<int>(), 0);
+    EXPECT_EQ(lexer.get<int>(), 0);
+    EXPECT_EQ(lexer.get<int>(), 8);
+    EXPECT_EQ(lexer.read().str, "$EndMeshFormat");
+    EXPECT_EQ(lexer.read().as<std::string>(), "name with spaces");
+    EXPECT_EQ(lexer.read().type, MshLexer::Token::EndOfFile);
+    EXPECT_EQ(lexer.get_num_tokens(), 7);
+    EXPECT_EQ(lexer.get_num_values(), 2);
+    EXPECT_EQ(lexer.get_num_bytes(), in.str().size());
+}
+
+TEST(MshLexerTest, bulk_get)
+{
+    std::string text;
+    std::vector<int> ints;
+    std::vector<double> dbls;
+    for (int i = 0; i < 5000; i++) {
+        ints.push_back(i * 7 - 100);
+        dbls.push_back(i * 0.25 - 3);
+        text += std::to_string(ints.back()) + (i % 10 == 9 ? "\n" : " ");
+    }
+    for (auto & d : dbls)
+        text += std::to_string(d) + "\r\n";
+    // `+1` is not accepted by `from_chars`, the general path decodes it
+    text += "+1 2\n";
+
+    // chunks smaller and larger than the SIMD width, and a plain string stream
+    for (std::size_t chunk : { 1, 7, 33, 100000 }) {
+        ChunkedStreamBuf buf(text, chunk);
+        std::istream in(&buf);
+        MshLexer lexer(&in);
+        EXPECT_EQ(lexer.get<int>(), ints[0]);
+        std::vector<int> ints_read(ints.size() - 1);
+        lexer.get(ints_read.data(), ints_read.size());
+        EXPECT_TRUE(std::equal(ints_read.begin(), ints_read.end(), ints.begin() + 1));
+        std::vector<double> dbls_read(dbls.size());
+        lexer.get(dbls_read.data(), dbls_read.size());
+        EXPECT_EQ(dbls_read, dbls);
+        std::size_t rest[2];
+        lexer.get(rest, 2);
+        EXPECT_EQ(rest[0], 1u);
+        EXPECT_EQ(rest[1], 2u);
+        EXPECT_EQ(lexer.read().type, MshLexer::Token::EndOfFile);
+        EXPECT_EQ(lexer.get_num_values(), ints.size() + dbls.size() + 2);
+        EXPECT_EQ(lexer.get_num_bytes(), text.size());
+    }
+}
+
+TEST(MshLexerTest, doubles)
+{
+    std::istringstream in("1.5 -0 .5 5. 1E3 +2.5 0x1p3 -1.7976931348623157e308 2.5e-300 "
+                          "0.1000000000000000055511151231257827 123456789012345678901234567890\n");
+    MshLexer lexer(&in);
+    double vals[11];
+    lexer.get(vals, 11);
+    EXPECT_EQ(vals[0], 1.5);
+    EXPECT_EQ(vals[1], 0.);
+    EXPECT_TRUE(std::signbit(vals[1]));
+    EXPECT_EQ(vals[2], 0.5);
+    EXPECT_EQ(vals[3], 5.);
+    EXPECT_EQ(vals[4], 1000.);
+    // not accepted by `from_chars`, decoded by the general path
+    EXPECT_EQ(vals[5], 2.5);
+    EXPECT_EQ(vals[6], 8.);
+    EXPECT_EQ(vals[7], -1.7976931348623157e308);
+    EXPECT_EQ(vals[8], 2.5e-300);
+    // correctly rounded
+    EXPECT_EQ(vals[9], 0.1);
+    EXPECT_EQ(vals[10], 123456789012345678901234567890.);
+}
+
+TEST(MshLexerTest, long_token)
+{
+    std::string name(200000, 'x');
+    std::istringstream in("\"" + name + "\" 1" + std::string(300, ' ') + "2\n");
+    MshLexer lexer(&in);
+    EXPECT_EQ(lexer.read().as<std::string>(), name);
+    int vals[2];
+    lexer.get(vals, 2);
+    EXPECT_EQ(vals[0], 1);
+    EXPECT_EQ(vals[1], 2);
+}
+
+TEST(MshLexerTest, binary)
+{
+    std::string text = "1\n";
+    int ints[3] = { 3, 4, 5 };
+    text.append(reinterpret_cast<const char *>(ints), sizeof(ints));
+    std::vector<double> dbls(20000, 1.5);
+    text.append(reinterpret_cast<const char *>(dbls.data()), dbls.size() * sizeof(double));
+    text += "\n$End\n";
+
+    ChunkedStreamBuf buf(text, 5);
+    std::istream in(&buf);
+    MshLexer lexer(&in);
+    EXPECT_EQ(lexer.get<int>(), 1);
+    lexer.set_binary(true);
+    EXPECT_EQ(lexer.get<int>(), 3);
+    EXPECT_EQ(lexer.read_blob<int>(), 4);
+    EXPECT_EQ(lexer.get<int>(), 5);
+    std::vector<double> dbls_read(dbls.size());
+    lexer.get(dbls_read.data(), dbls_read.size());
+    EXPECT_EQ(dbls_read, dbls);
+    lexer.set_binary(false);
+    EXPECT_EQ(lexer.read().str, "$End");
+    lexer.set_binary(true);
+    EXPECT_THROW_MSG(lexer.read_blob<int>(), "Reached end of file");
+}
+
+TEST(MshLexerTest, errors)
+{
+    {
+        std::istringstream in("1 2");
+        MshLexer lexer(&in);
+        EXPECT_EQ(lexer.get<int>(), 1);
+        EXPECT_THROW_MSG(lexer.get<int>(), "Reached end of file");
+    }
+    {
+        std::istringstream in("\"abc");
+        MshLexer lexer(&in);
+        EXPECT_THROW_MSG(lexer.read(), "Reached end of file");
+    }
+    {
+        std::istringstream in("1 $Nodes\n");
+        MshLexer lexer(&in);
+        int vals[2];
+        EXPECT_THROW_MSG(lexer.get(vals, 2), "Token is not a number");
+    }
+    {
+        std::istringstream in("   \n");
+        MshLexer lexer(&in);
+        EXPECT_EQ(lexer.read().type, MshLexer::Token::EndOfFile);
+    }
+}
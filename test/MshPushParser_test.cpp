@@ -0,0 +1,150 @@
+#include <gmock/gmock.h>
+#include "TestConfig.h"
+#include "ExceptionTestMacros.h"
+#include "MshFileTestUtils.h"
+#include "gmshparsercpp/MshPushParser.h"
+#include <fstream>
+#include <memory_resource>
+#include <sstream>
+#include <thread>
+
+using namespace gmshparsercpp;
+using namespace testing;
+
+namespace {
+
+std::string
+read_file(const std::string & file_name)
+{
+    std::ifstream file(file_name, std::ios::binary);
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+}
+
+} // namespace
+
+TEST(MshPushParserTest, chunks)
+{
+    for (auto name : { "/quad-v4.asc.msh", "/quad-v2.bin.msh", "/prism-v4.bin.msh" }) {
+        std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + name;
+        MshFile gold(file_name);
+        gold.parse();
+
+        auto data = read_file(file_name);
+        for (std::size_t chunk_size : { 1, 7, 64, 4096 }) {
+            // small capacity, so that the feeding thread has to wait for the parser
+            MshPushParser parser(16);
+            for (std::size_t i = 0; i < data.size(); i += chunk_size)
+                parser.feed(data.data() + i, std::min(chunk_size, data.size() - i));
+            EXPECT_NO_THROW({ parser.finish(); });
+            expect_same_mesh(parser.get_file(), gold);
+        }
+    }
+}
+
+TEST(MshPushParserTest, try_feed)
+{
+    for (auto name : { "/quad-v4.asc.msh", "/prism-v4.bin.msh" }) {
+        std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + name;
+        MshFile gold(file_name);
+        gold.parse();
+
+        auto data = read_file(file_name);
+        MshPushParser parser(16);
+        std::size_t n_would_block = 0;
+        for (std::size_t i = 0; i < data.size();) {
+            auto n = parser.try_feed(data.data() + i, std::min<std::size_t>(64, data.size() - i));
+            EXPECT_LE(n, 16);
+            if (n == 0) {
+                // queue is full, come back later
+                n_would_block++;
+                std::this_thread::yield();
+            }
+            i += n;
+        }
+        EXPECT_NO_THROW({ parser.finish(); });
+        expect_same_mesh(parser.get_file(), gold);
+        EXPECT_GT(n_would_block, 0);
+    }
+}
+
+TEST(MshPushParserTest, try_feed_error)
+{
+    std::string data = "garbage\n";
+    MshPushParser parser;
+    EXPECT_EQ(parser.try_feed(data.data(), data.size()), data.size());
+    EXPECT_THROW_MSG(parser.finish(), "Expected start of section marker not found.");
+    EXPECT_THROW_MSG(parser.try_feed(data.data(), data.size()),
+                     "Cannot feed data after the input was finished.");
+}
+
+TEST(MshPushParserTest, setup)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + "/prism-v4.bin.msh";
+    auto data = read_file(file_name);
+    MshPushParser parser;
+    parser.set_setup_callback([](MshFile & file) {
+        file.set_num_threads(2);
+        file.set_coordinate_precision(MshFile::Precision::SINGLE);
+        file.set_collect_stats(true);
+    });
+    parser.feed(data.data(), data.size());
+    EXPECT_THROW_MSG(parser.set_setup_callback([](MshFile &) {}),
+                     "Cannot set up the parser after data was fed.");
+    parser.finish();
+
+    auto & f = parser.get_file();
+    ASSERT_FALSE(f.get_nodes().empty());
+    EXPECT_TRUE(f.get_nodes()[0].coordinates.empty());
+    EXPECT_FALSE(f.get_nodes()[0].float_coordinates.empty());
+    EXPECT_FALSE(f.get_stats().sections.empty());
+}
+
+TEST(MshPushParserTest, release)
+{
+    std::string file_name = std::string(GMSHPARSERCPP_ASSETS_DIR) + "/quad-v4.asc.msh";
+    MshFile gold(file_name);
+    gold.parse();
+
+    auto data = read_file(file_name);
+    std::pmr::monotonic_buffer_resource arena;
+    MshPushParser parser(1 << 22, &arena);
+    EXPECT_THROW_MSG(parser.release(), "Parsing is not finished.");
+    parser.feed(data.data(), data.size());
+    parser.finish();
+
+    auto resource = parser.get_file().get_memory_resource();
+#ifndef GMSHPARSERCPP_COUNT_ALLOCATIONS
+    EXPECT_EQ(resource, &arena);
+#endif
+    auto mesh = parser.release();
+    EXPECT_EQ(mesh.nodes.size(), gold.get_nodes().size());
+    EXPECT_EQ(mesh.element_blocks.size(), gold.get_element_blocks().size());
+    EXPECT_EQ(mesh.nodes.get_allocator().resource(), resource);
+    EXPECT_TRUE(parser.get_file().get_nodes().empty());
+}
+
+TEST(MshPushParserTest, error)
+{
+    std::string data = "garbage\n";
+    MshPushParser parser;
+    parser.feed(data.data(), data.size());
+    EXPECT_THROW_MSG(parser.finish(), "Expected start of section marker not found.");
+}
+
+TEST(MshPushParserTest, not_finished)
+{
+    MshPushParser parser;
+    EXPECT_THROW_MSG(parser.get_file(), "Parsing is not finished.");
+}
+
+TEST(MshPushParserTest, feed_after_finish)
+{
+    std::string data = read_file(std::string(GMSHPARSERCPP_ASSETS_DIR) + "/header-only.msh");
+    MshPushParser parser;
+    parser.feed(data.data(), data.size());
+    parser.finish();
+    EXPECT_THROW_MSG(parser.feed(data.data(), data.size()),
+                     "Cannot feed data after the input was finished.");
+}
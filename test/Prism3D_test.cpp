@@ -132,11 +132,11 @@ TEST(Prism3DTest, v4_asc)
 
     auto el_blks = f.get_element_blocks();
     for (std::size_t i = 0; i < el_blks.size(); i++) {
-        EXPECT_EQ(el_blks[i].elements.size(), gold::v4::block_elem_size[i]);
+        EXPECT_EQ(el_blks[i].size(), gold::v4::block_elem_size[i]);
         EXPECT_EQ(el_blks[i].element_type, gold::v4::block_elem_type[i]);
-        for (std::size_t j = 0; j < el_blks[i].elements.size(); j++) {
-            for (std::size_t k = 0; k < el_blks[i].elements[j].node_tags.size(); k++)
-                EXPECT_EQ(el_blks[i].elements[j].node_tags[k], gold::v4::block_elem_conn[i][j][k]);
+        for (std::size_t j = 0; j < el_blks[i].size(); j++) {
+            for (std::size_t k = 0; k < gold::v4::block_elem_conn[i][j].size(); k++)
+                EXPECT_EQ(el_blks[i].get_node_tags(j)[k], gold::v4::block_elem_conn[i][j][k]);
         }
     }
 }
@@ -171,11 +171,11 @@ TEST(Prism3DTest, v4_bin)
 
     auto el_blks = f.get_element_blocks();
     for (std::size_t i = 0; i < el_blks.size(); i++) {
-        EXPECT_EQ(el_blks[i].elements.size(), gold::v4::block_elem_size[i]);
+        EXPECT_EQ(el_blks[i].size(), gold::v4::block_elem_size[i]);
         EXPECT_EQ(el_blks[i].element_type, gold::v4::block_elem_type[i]);
-        for (std::size_t j = 0; j < el_blks[i].elements.size(); j++) {
-            for (std::size_t k = 0; k < el_blks[i].elements[j].node_tags.size(); k++)
-                EXPECT_EQ(el_blks[i].elements[j].node_tags[k], gold::v4::block_elem_conn[i][j][k]);
+        for (std::size_t j = 0; j < el_blks[i].size(); j++) {
+            for (std::size_t k = 0; k < gold::v4::block_elem_conn[i][j].size(); k++)
+                EXPECT_EQ(el_blks[i].get_node_tags(j)[k], gold::v4::block_elem_conn[i][j][k]);
         }
     }
 }
@@ -209,11 +209,11 @@ TEST(Prism3DTest, v2_asc)
 
     auto el_blks = f.get_element_blocks();
     for (std::size_t i = 0; i < el_blks.size(); i++) {
-        EXPECT_EQ(el_blks[i].elements.size(), gold::v2::block_elem_size[i]);
+        EXPECT_EQ(el_blks[i].size(), gold::v2::block_elem_size[i]);
         EXPECT_EQ(el_blks[i].element_type, gold::v2::block_elem_type[i]);
-        for (std::size_t j = 0; j < el_blks[i].elements.size(); j++) {
-            for (std::size_t k = 0; k < el_blks[i].elements[j].node_tags.size(); k++)
-                EXPECT_EQ(el_blks[i].elements[j].node_tags[k], gold::v2::block_elem_conn[i][j][k]);
+        for (std::size_t j = 0; j < el_blks[i].size(); j++) {
+            for (std::size_t k = 0; k < gold::v2::block_elem_conn[i][j].size(); k++)
+                EXPECT_EQ(el_blks[i].get_node_tags(j)[k], gold::v2::block_elem_conn[i][j][k]);
         }
     }
 }
@@ -247,11 +247,11 @@ TEST(Prism3DTest, v2_bin)
 
     auto el_blks = f.get_element_blocks();
     for (std::size_t i = 0; i < el_blks.size(); i++) {
-        EXPECT_EQ(el_blks[i].elements.size(), gold::v2::block_elem_size[i]);
+        EXPECT_EQ(el_blks[i].size(), gold::v2::block_elem_size[i]);
         EXPECT_EQ(el_blks[i].element_type, gold::v2::block_elem_type[i]);
-        for (std::size_t j = 0; j < el_blks[i].elements.size(); j++) {
-            for (std::size_t k = 0; k < el_blks[i].elements[j].node_tags.size(); k++)
-                EXPECT_EQ(el_blks[i].elements[j].node_tags[k], gold::v2::block_elem_conn[i][j][k]);
+        for (std::size_t j = 0; j < el_blks[i].size(); j++) {
+            for (std::size_t k = 0; k < gold::v2::block_elem_conn[i][j].size(); k++)
+                EXPECT_EQ(el_blks[i].get_node_tags(j)[k], gold::v2::block_elem_conn[i][j][k]);
         }
     }
 }
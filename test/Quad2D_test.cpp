@@ -58,10 +58,10 @@ TEST(Quad2DTest, v4_asc)
         { { 3, 4 } }, { { 4, 1 } }, { { 2, 5, 1 }, { 1, 5, 4 }, { 3, 5, 2 }, { 4, 5, 3 } },
     };
     for (std::size_t i = 0; i < el_blks.size(); i++) {
-        EXPECT_EQ(el_blks[i].elements.size(), conn[i].size());
-        for (std::size_t j = 0; j < el_blks[i].elements.size(); j++) {
-            for (std::size_t k = 0; k < el_blks[i].elements[j].node_tags.size(); k++)
-                EXPECT_EQ(el_blks[i].elements[j].node_tags[k], conn[i][j][k]);
+        EXPECT_EQ(el_blks[i].size(), conn[i].size());
+        for (std::size_t j = 0; j < el_blks[i].size(); j++) {
+            for (std::size_t k = 0; k < conn[i][j].size(); k++)
+                EXPECT_EQ(el_blks[i].get_node_tags(j)[k], conn[i][j][k]);
         }
     }
 }
@@ -116,10 +116,10 @@ TEST(Quad2DTest, v4_bin)
         { { 4, 1 } },
     };
     for (std::size_t i = 0; i < el_blks.size(); i++) {
-        EXPECT_EQ(el_blks[i].elements.size(), conn[i].size());
-        for (std::size_t j = 0; j < el_blks[i].elements.size(); j++) {
-            for (std::size_t k = 0; k < el_blks[i].elements[j].node_tags.size(); k++)
-                EXPECT_EQ(el_blks[i].elements[j].node_tags[k], conn[i][j][k]);
+        EXPECT_EQ(el_blks[i].size(), conn[i].size());
+        for (std::size_t j = 0; j < el_blks[i].size(); j++) {
+            for (std::size_t k = 0; k < conn[i][j].size(); k++)
+                EXPECT_EQ(el_blks[i].get_node_tags(j)[k], conn[i][j][k]);
         }
     }
 }
@@ -161,10 +161,10 @@ TEST(Quad2DTest, v2_asc)
         { { 4, 1 } },
     };
     for (std::size_t i = 0; i < el_blks.size(); i++) {
-        EXPECT_EQ(el_blks[i].elements.size(), conn[i].size());
-        for (std::size_t j = 0; j < el_blks[i].elements.size(); j++) {
-            for (std::size_t k = 0; k < el_blks[i].elements[j].node_tags.size(); k++)
-                EXPECT_EQ(el_blks[i].elements[j].node_tags[k], conn[i][j][k]);
+        EXPECT_EQ(el_blks[i].size(), conn[i].size());
+        for (std::size_t j = 0; j < el_blks[i].size(); j++) {
+            for (std::size_t k = 0; k < conn[i][j].size(); k++)
+                EXPECT_EQ(el_blks[i].get_node_tags(j)[k], conn[i][j][k]);
         }
     }
 }
@@ -206,10 +206,10 @@ TEST(Quad2DTest, v2_bin)
         { { 4, 1 } },
     };
     for (std::size_t i = 0; i < el_blks.size(); i++) {
-        EXPECT_EQ(el_blks[i].elements.size(), conn[i].size());
-        for (std::size_t j = 0; j < el_blks[i].elements.size(); j++) {
-            for (std::size_t k = 0; k < el_blks[i].elements[j].node_tags.size(); k++)
-                EXPECT_EQ(el_blks[i].elements[j].node_tags[k], conn[i][j][k]);
+        EXPECT_EQ(el_blks[i].size(), conn[i].size());
+        for (std::size_t j = 0; j < el_blks[i].size(); j++) {
+            for (std::size_t k = 0; k < conn[i][j].size(); k++)
+                EXPECT_EQ(el_blks[i].get_node_tags(j)[k], conn[i][j][k]);
         }
     }
 }
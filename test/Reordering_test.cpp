@@ -0,0 +1,395 @@
+#include <gmock/gmock.h>
+#include "TestConfig.h"
+#include "ExceptionTestMacros.h"
+#include "gmshparsercpp/Reordering.h"
+#include "gmshparsercpp/Topology.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <random>
+
+using namespace gmshparsercpp;
+using namespace testing;
+
+namespace {
+
+/// Nodes of an `n x n x n` grid with shuffled tags `1..n^3`, coordinates are the grid indices
+std::pmr::vector<MshFile::Node>
+shuffled_grid_nodes(int n)
+{
+    MshFile::Node node;
+    node.dimension = 3;
+    node.entity_tag = 1;
+    for (int z = 0; z < n; z++)
+        for (int y = 0; y < n; y++)
+            for (int x = 0; x < n; x++)
+                node.coordinates.emplace_back(x, y, z);
+    node.tags.resize(node.coordinates.size());
+    std::iota(node.tags.begin(), node.tags.end(), 1);
+    std::mt19937 gen(1234);
+    std::shuffle(node.tags.begin(), node.tags.end(), gen);
+    std::pmr::vector<MshFile::Node> nodes;
+    nodes.push_back(std::move(node));
+    return nodes;
+}
+
+/// HEX8 elements filling the grid of `shuffled_grid_nodes`
+std::pmr::vector<MshFile::ElementBlock>
+grid_hexes(const std::pmr::vector<MshFile::Node> & nodes, int n)
+{
+    auto t = [&](int x, int y, int z) { return nodes[0].tags[x + n * (y + n * z)]; };
+    MshFile::ElementBlock blk;
+    blk.dimension = 3;
+    blk.tag = 1;
+    blk.element_type = HEX8;
+    for (int z = 0; z + 1 < n; z++)
+        for (int y = 0; y + 1 < n; y++)
+            for (int x = 0; x + 1 < n; x++) {
+                blk.element_tags.push_back(blk.element_tags.size() + 1);
+                for (int v : { t(x, y, z),
+                               t(x + 1, y, z),
+                               t(x + 1, y + 1, z),
+                               t(x, y + 1, z),
+                               t(x, y, z + 1),
+                               t(x + 1, y, z + 1),
+                               t(x + 1, y + 1, z + 1),
+                               t(x, y + 1, z + 1) })
+                    blk.connectivity.push_back(v);
+            }
+    std::pmr::vector<MshFile::ElementBlock> blocks;
+    blocks.push_back(std::move(blk));
+    return blocks;
+}
+
+/// Coordinates of each node by tag
+std::map<int, MshFile::Point>
+points_by_tag(const std::pmr::vector<MshFile::Node> & nodes)
+{
+    std::map<int, MshFile::Point> pts;
+    for (auto & blk : nodes)
+        for (std::size_t i = 0; i < blk.tags.size(); i++)
+            pts[blk.tags[i]] = blk.coordinates[i];
+    return pts;
+}
+
+/// Element connectivity given by node coordinates (independent of the numbering)
+std::vector<std::vector<double>>
+element_points(const std::pmr::vector<MshFile::Node> & nodes,
+               const std::pmr::vector<MshFile::ElementBlock> & blocks)
+{
+    auto pts = points_by_tag(nodes);
+    std::vector<std::vector<double>> elems;
+    for (auto & blk : blocks)
+        for (std::size_t e = 0; e < blk.size(); e++) {
+            std::vector<double> elem;
+            for (int j = 0; j < blk.get_num_nodes_per_element(); j++) {
+                auto & p = pts.at(blk.get_node_tags(e)[j]);
+                elem.insert(elem.end(), { p.x, p.y, p.z });
+            }
+            elems.push_back(elem);
+        }
+    return elems;
+}
+
+/// Largest difference of tags of two nodes in one element
+int
+bandwidth(const std::pmr::vector<MshFile::ElementBlock> & blocks)
+{
+    int bw = 0;
+    for (auto & blk : blocks)
+        for (std::size_t e = 0; e < blk.size(); e++) {
+            auto conn = blk.get_node_tags(e);
+            auto [lo, hi] = std::minmax_element(conn, conn + blk.get_num_nodes_per_element());
+            bw = std::max(bw, *hi - *lo);
+        }
+    return bw;
+}
+
+} // namespace
+
+TEST(ReorderingTest, rcm_chain)
+{
+    // chain 3 - 1 - 5 - 2 - 4 along the x-axis
+    MshFile::Node node;
+    node.tags = { 1, 2, 3, 4, 5 };
+    node.coordinates = { { 1, 0, 0 }, { 3, 0, 0 }, { 0, 0, 0 }, { 4, 0, 0 }, { 2, 0, 0 } };
+    std::pmr::vector<MshFile::Node> nodes;
+    nodes.push_back(node);
+    MshFile::ElementBlock blk;
+    blk.dimension = 1;
+    blk.element_type = LINE2;
+    blk.element_tags = { 1, 2, 3, 4 };
+    blk.connectivity = { 3, 1, 1, 5, 5, 2, 2, 4 };
+    std::pmr::vector<MshFile::ElementBlock> blocks;
+    blocks.push_back(blk);
+
+    auto perm = reorder_nodes(nodes, blocks, NodeOrdering::RCM, 2);
+    // traversal starts from an end of the chain (pseudo-peripheral node)
+    EXPECT_THAT(perm, ElementsAre(2, 0, 4, 1, 3));
+    EXPECT_THAT(blocks[0].connectivity, ElementsAre(1, 2, 2, 3, 3, 4, 4, 5));
+    EXPECT_THAT(nodes[0].tags, ElementsAre(1, 2, 3, 4, 5));
+    for (std::size_t i = 0; i < 5; i++)
+        EXPECT_EQ(nodes[0].coordinates[i].x, i);
+}
+
+TEST(ReorderingTest, rcm_grid)
+{
+    const int n = 6;
+    auto nodes = shuffled_grid_nodes(n);
+    auto blocks = grid_hexes(nodes, n);
+    auto elems = element_points(nodes, blocks);
+    auto bw = bandwidth(blocks);
+
+    auto perm = reorder_nodes(nodes, blocks, NodeOrdering::RCM, 3);
+    ASSERT_EQ(perm.size(), n * n * n);
+    std::vector<std::size_t> sorted(perm);
+    std::sort(sorted.begin(), sorted.end());
+    for (std::size_t i = 0; i < sorted.size(); i++)
+        EXPECT_EQ(sorted[i], i);
+
+    // same mesh, numbered differently
+    EXPECT_EQ(element_points(nodes, blocks), elems);
+    EXPECT_TRUE(std::is_sorted(nodes[0].tags.begin(), nodes[0].tags.end()));
+    // RCM numbers the grid shell by shell around a corner, the largest shell has `3 n^2` nodes
+    EXPECT_LE(bandwidth(blocks), 3 * n * n);
+    EXPECT_LT(bandwidth(blocks), bw / 2);
+}
+
+TEST(ReorderingTest, hilbert_grid)
+{
+    const int n = 4;
+    auto nodes = shuffled_grid_nodes(n);
+    auto blocks = grid_hexes(nodes, n);
+    auto elems = element_points(nodes, blocks);
+
+    reorder_nodes(nodes, blocks, NodeOrdering::HILBERT, 2);
+    EXPECT_EQ(element_points(nodes, blocks), elems);
+    // consecutive nodes along the Hilbert curve are neighbors in the grid
+    auto & pts = nodes[0].coordinates;
+    ASSERT_EQ(pts.size(), n * n * n);
+    for (std::size_t i = 1; i < pts.size(); i++) {
+        auto d = std::abs(pts[i].x - pts[i - 1].x) + std::abs(pts[i].y - pts[i - 1].y) +
+                 std::abs(pts[i].z - pts[i - 1].z);
+        EXPECT_EQ(d, 1.) << "at node " << i;
+    }
+}
+
+TEST(ReorderingTest, morton_grid)
+{
+    const int n = 2;
+    auto nodes = shuffled_grid_nodes(n);
+    auto blocks = grid_hexes(nodes, n);
+
+    auto perm = reorder_nodes(nodes, blocks, NodeOrdering::MORTON, 1);
+    // Z-order with x varying fastest is the original grid order
+    EXPECT_THAT(perm, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7));
+    EXPECT_THAT(nodes[0].tags, ElementsAre(1, 2, 3, 4, 5, 6, 7, 8));
+    EXPECT_THAT(blocks[0].connectivity, ElementsAre(1, 2, 4, 3, 5, 6, 8, 7));
+    for (std::size_t i = 0; i < 8; i++) {
+        EXPECT_EQ(nodes[0].coordinates[i].x, i % 2);
+        EXPECT_EQ(nodes[0].coordinates[i].y, i / 2 % 2);
+        EXPECT_EQ(nodes[0].coordinates[i].z, i / 4);
+    }
+}
+
+TEST(ReorderingTest, node_blocks)
+{
+    // nodes stay in their blocks, tags are taken from the set of all tags
+    MshFile::Node b0;
+    b0.dimension = 0;
+    b0.tags = { 10, 20 };
+    b0.float_coordinates = { { 3, 0, 0 }, { 0, 0, 0 } };
+    MshFile::Node b1;
+    b1.dimension = 1;
+    b1.parametric = true;
+    b1.tags = { 30, 40 };
+    b1.float_coordinates = { { 2, 0, 0 }, { 1, 0, 0 } };
+    b1.float_par_coords = { 0.75f, 0.25f };
+    std::pmr::vector<MshFile::Node> nodes;
+    nodes.push_back(b0);
+    nodes.push_back(b1);
+    MshFile::ElementBlock blk;
+    blk.dimension = 1;
+    blk.element_type = LINE2;
+    blk.element_tags = { 1, 2, 3 };
+    blk.connectivity = { 20, 40, 40, 30, 30, 10 };
+    std::pmr::vector<MshFile::ElementBlock> blocks;
+    blocks.push_back(blk);
+
+    auto perm = reorder_nodes(nodes, blocks, NodeOrdering::MORTON, 2);
+    EXPECT_THAT(perm, ElementsAre(1, 3, 2, 0));
+    EXPECT_THAT(nodes[0].tags, ElementsAre(10, 40));
+    EXPECT_EQ(nodes[0].float_coordinates[0].x, 0.f);
+    EXPECT_EQ(nodes[0].float_coordinates[1].x, 3.f);
+    EXPECT_THAT(nodes[1].tags, ElementsAre(20, 30));
+    EXPECT_EQ(nodes[1].float_coordinates[0].x, 1.f);
+    EXPECT_EQ(nodes[1].float_coordinates[1].x, 2.f);
+    EXPECT_THAT(nodes[1].float_par_coords, ElementsAre(0.25f, 0.75f));
+    EXPECT_THAT(blocks[0].connectivity, ElementsAre(10, 20, 20, 30, 30, 40));
+}
+
+TEST(ReorderingTest, unknown_tag)
+{
+    for (auto ordering : { NodeOrdering::RCM, NodeOrdering::MORTON, NodeOrdering::HILBERT }) {
+        auto nodes = shuffled_grid_nodes(3);
+        auto blocks = grid_hexes(nodes, 3);
+        MshFile::ElementBlock bad;
+        bad.element_type = LINE2;
+        bad.element_tags = { 9 };
+        bad.connectivity = { 1, 999 };
+        blocks.push_back(std::move(bad));
+        auto tags = nodes[0].tags;
+        auto conn = blocks[0].connectivity;
+
+        EXPECT_THROW_MSG(reorder_nodes(nodes, blocks, ordering, 2), "Unknown node tag '999'.");
+        EXPECT_EQ(nodes[0].tags, tags);
+        EXPECT_EQ(blocks[0].connectivity, conn);
+        EXPECT_THAT(blocks[1].connectivity, ElementsAre(1, 999));
+    }
+}
+
+TEST(ReorderingTest, file)
+{
+    for (auto ordering : { NodeOrdering::RCM, NodeOrdering::MORTON, NodeOrdering::HILBERT }) {
+        MshFile f(std::string(GMSHPARSERCPP_ASSETS_DIR) + "/prism-v4.asc.msh");
+        f.parse();
+        auto mesh = f.release();
+        auto elems = element_points(mesh.nodes, mesh.element_blocks);
+        auto perm = reorder_nodes(mesh.nodes, mesh.element_blocks, ordering, 2);
+        EXPECT_EQ(perm.size(), NodeNumbering(mesh.nodes).size());
+        EXPECT_EQ(element_points(mesh.nodes, mesh.element_blocks), elems);
+        for (auto & blk : mesh.nodes)
+            EXPECT_TRUE(std::is_sorted(blk.tags.begin(), blk.tags.end()));
+    }
+}
+
+TEST(ReorderingTest, merge_v2)
+{
+    for (auto ordering : { NodeOrdering::RCM, NodeOrdering::MORTON, NodeOrdering::HILBERT }) {
+        MshFile f(std::string(GMSHPARSERCPP_ASSETS_DIR) + "/prism-v2.asc.msh");
+        f.parse();
+        auto mesh = f.release();
+        // v2 files have one node per block, so keeping the blocks cannot reorder coordinates
+        ASSERT_EQ(mesh.nodes.size(), 15);
+        std::vector<MshFile::Point> pts;
+        for (auto & blk : mesh.nodes)
+            pts.insert(pts.end(), blk.coordinates.begin(), blk.coordinates.end());
+        auto elems = element_points(mesh.nodes, mesh.element_blocks);
+
+        auto perm = reorder_nodes(mesh.nodes, mesh.element_blocks, ordering, 2, NodeLayout::MERGE);
+        ASSERT_EQ(perm.size(), 15);
+        ASSERT_EQ(mesh.nodes.size(), 1);
+        auto & blk = mesh.nodes[0];
+        EXPECT_EQ(blk.tags.size(), 15);
+        EXPECT_TRUE(std::is_sorted(blk.tags.begin(), blk.tags.end()));
+        EXPECT_TRUE(blk.float_coordinates.empty());
+        ASSERT_EQ(blk.coordinates.size(), 15);
+        for (std::size_t k = 0; k < perm.size(); k++) {
+            EXPECT_DOUBLE_EQ(blk.coordinates[k].x, pts[perm[k]].x);
+            EXPECT_DOUBLE_EQ(blk.coordinates[k].y, pts[perm[k]].y);
+            EXPECT_DOUBLE_EQ(blk.coordinates[k].z, pts[perm[k]].z);
+        }
+        EXPECT_EQ(element_points(mesh.nodes, mesh.element_blocks), elems);
+    }
+}
+
+TEST(ReorderingTest, elements_hilbert)
+{
+    const int n = 9;
+    auto nodes = shuffled_grid_nodes(n);
+    auto blocks = grid_hexes(nodes, n);
+    auto & blk = blocks[0];
+    auto npe = blk.get_num_nodes_per_element();
+    // shuffle the elements
+    std::vector<std::size_t> shuffle(blk.size());
+    std::iota(shuffle.begin(), shuffle.end(), 0);
+    std::mt19937 gen(4321);
+    std::shuffle(shuffle.begin(), shuffle.end(), gen);
+    MshFile::ElementBlock shuffled = blk;
+    for (std::size_t i = 0; i < shuffle.size(); i++) {
+        shuffled.element_tags[i] = blk.element_tags[shuffle[i]];
+        std::copy_n(blk.get_node_tags(shuffle[i]), npe, shuffled.connectivity.begin() + i * npe);
+    }
+    blk = shuffled;
+
+    auto perms = reorder_elements(nodes, blocks, 4);
+    ASSERT_EQ(perms.size(), 1);
+    ASSERT_EQ(perms[0].size(), shuffled.size());
+    for (std::size_t i = 0; i < blk.size(); i++) {
+        EXPECT_EQ(blk.element_tags[i], shuffled.element_tags[perms[0][i]]);
+        EXPECT_TRUE(std::equal(blk.get_node_tags(i),
+                               blk.get_node_tags(i) + npe,
+                               shuffled.get_node_tags(perms[0][i])));
+    }
+
+    // consecutive elements along the Hilbert curve share a face
+    auto pts = points_by_tag(nodes);
+    auto centroid = [&](std::size_t e) {
+        MshFile::Point c;
+        for (int j = 0; j < npe; j++) {
+            auto & p = pts.at(blk.get_node_tags(e)[j]);
+            c = { c.x + p.x / npe, c.y + p.y / npe, c.z + p.z / npe };
+        }
+        return c;
+    };
+    for (std::size_t i = 1; i < blk.size(); i++) {
+        auto a = centroid(i - 1);
+        auto b = centroid(i);
+        EXPECT_NEAR(std::abs(a.x - b.x) + std::abs(a.y - b.y) + std::abs(a.z - b.z), 1., 1e-12)
+            << "at element " << i;
+    }
+}
+
+TEST(ReorderingTest, elements_unknown_tag)
+{
+    const int n = 4;
+    auto nodes = shuffled_grid_nodes(n);
+    auto blocks = grid_hexes(nodes, n);
+    auto & blk = blocks[0];
+    // reverse the elements, so that the first block would be permuted
+    std::reverse(blk.element_tags.begin(), blk.element_tags.end());
+    std::reverse(blk.connectivity.begin(), blk.connectivity.end());
+    auto tags = blk.element_tags;
+    auto conn = blk.connectivity;
+
+    MshFile::ElementBlock bad_tag;
+    bad_tag.element_type = LINE2;
+    bad_tag.element_tags = { 9 };
+    bad_tag.connectivity = { 1, 999 };
+    blocks.push_back(bad_tag);
+    EXPECT_THROW_MSG(reorder_elements(nodes, blocks, 2), "Unknown node tag '999'.");
+    EXPECT_EQ(blocks[0].element_tags, tags);
+    EXPECT_EQ(blocks[0].connectivity, conn);
+
+    blocks[1].element_type = NONE;
+    EXPECT_THROW_MSG(reorder_elements(nodes, blocks, 2), "Unknown element type 'NONE'");
+    EXPECT_EQ(blocks[0].element_tags, tags);
+    EXPECT_EQ(blocks[0].connectivity, conn);
+
+    // without the bad block, the first block does change
+    blocks.pop_back();
+    reorder_elements(nodes, blocks, 2);
+    EXPECT_NE(blocks[0].element_tags, tags);
+}
+
+TEST(ReorderingTest, elements_file)
+{
+    MshFile f(std::string(GMSHPARSERCPP_ASSETS_DIR) + "/prism-v4.asc.msh");
+    f.parse();
+    auto mesh = f.release();
+    auto blocks = mesh.element_blocks;
+    auto perms = reorder_elements(mesh.nodes, mesh.element_blocks, 2);
+    ASSERT_EQ(perms.size(), blocks.size());
+    for (std::size_t b = 0; b < blocks.size(); b++) {
+        auto & blk = mesh.element_blocks[b];
+        auto npe = blk.get_num_nodes_per_element();
+        ASSERT_EQ(perms[b].size(), blocks[b].size());
+        for (std::size_t i = 0; i < blk.size(); i++) {
+            EXPECT_EQ(blk.element_tags[i], blocks[b].element_tags[perms[b][i]]);
+            EXPECT_TRUE(std::equal(blk.get_node_tags(i),
+                                   blk.get_node_tags(i) + npe,
+                                   blocks[b].get_node_tags(perms[b][i])));
+        }
+    }
+}
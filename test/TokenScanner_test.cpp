@@ -0,0 +1,126 @@
+#include <gmock/gmock.h>
+#include "TokenScanner.h"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace gmshparsercpp;
+
+namespace {
+
+std::vector<const TokenScanner *>
+available_scanners()
+{
+    std::vector<const TokenScanner *> scanners;
+    for (auto isa : { ScannerIsa::SCALAR, ScannerIsa::SSE2, ScannerIsa::AVX2 })
+        if (auto scanner = token_scanner(isa))
+            scanners.push_back(scanner);
+    return scanners;
+}
+
+/// Random tokens separated by random runs of white space
+std::string
+random_text(std::mt19937 & gen, std::size_t size)
+{
+    const std::string ws = " \t\r\n";
+    const std::string chars = "0123456789.-+eE$\"abc";
+    std::uniform_int_distribution<int> run(1, 40);
+    std::string text;
+    bool token = gen() % 2;
+    while (text.size() < size) {
+        auto n = run(gen);
+        auto & alphabet = token ? chars : ws;
+        for (int i = 0; i < n; i++)
+            text += alphabet[gen() % alphabet.size()];
+        token = !token;
+    }
+    return text;
+}
+
+struct Tokens {
+    std::vector<std::uint32_t> starts;
+    std::vector<std::uint32_t> ends;
+};
+
+Tokens
+scan(const TokenScanner & scanner, const std::string & text, std::size_t max_tokens)
+{
+    Tokens tokens;
+    tokens.starts.resize(max_tokens);
+    tokens.ends.resize(max_tokens);
+    auto n = scanner.scan_tokens(text.data(),
+                                 text.data() + text.size(),
+                                 tokens.starts.data(),
+                                 tokens.ends.data(),
+                                 max_tokens);
+    tokens.starts.resize(n);
+    tokens.ends.resize(n);
+    return tokens;
+}
+
+} // namespace
+
+TEST(TokenScannerTest, best)
+{
+    auto & best = token_scanner();
+    EXPECT_EQ(token_scanner(best.isa), &best);
+    EXPECT_NE(token_scanner(ScannerIsa::SCALAR), nullptr);
+}
+
+TEST(TokenScannerTest, scan_tokens)
+{
+    std::string text = "  12 -3.5\t\n$Nodes\r\n\"a b\" 7";
+    for (auto scanner : available_scanners()) {
+        auto tokens = scan(*scanner, text, 10);
+        // `7` is not followed by white space, so it is not complete
+        EXPECT_THAT(tokens.starts, testing::ElementsAre(2, 5, 11, 19, 22));
+        EXPECT_THAT(tokens.ends, testing::ElementsAre(4, 9, 17, 21, 24));
+
+        tokens = scan(*scanner, text, 2);
+        EXPECT_THAT(tokens.starts, testing::ElementsAre(2, 5));
+        EXPECT_THAT(tokens.ends, testing::ElementsAre(4, 9));
+    }
+}
+
+TEST(TokenScannerTest, skip_find_whitespace)
+{
+    std::string text = std::string(50, ' ') + "\t\r\n" + std::string(70, 'x') + " ";
+    auto begin = text.data();
+    auto end = begin + text.size();
+    for (auto scanner : available_scanners()) {
+        EXPECT_EQ(scanner->skip_whitespace(begin, end), begin + 53);
+        EXPECT_EQ(scanner->find_whitespace(begin + 53, end), begin + 123);
+        EXPECT_EQ(scanner->find_whitespace(begin + 53, end - 1), end - 1);
+        EXPECT_EQ(scanner->skip_whitespace(begin, begin + 40), begin + 40);
+        EXPECT_EQ(scanner->skip_whitespace(begin, begin), begin);
+    }
+}
+
+TEST(TokenScannerTest, same_as_scalar)
+{
+    std::mt19937 gen(1234);
+    auto & scalar = *token_scanner(ScannerIsa::SCALAR);
+    for (int rep = 0; rep < 50; rep++) {
+        // odd sizes leave a partial chunk at the end
+        auto text = random_text(gen, 1000 + rep * 37);
+        for (std::size_t max_tokens : { 1, 5, 1000 }) {
+            auto gold = scan(scalar, text, max_tokens);
+            for (auto scanner : available_scanners()) {
+                auto tokens = scan(*scanner, text, max_tokens);
+                EXPECT_EQ(tokens.starts, gold.starts);
+                EXPECT_EQ(tokens.ends, gold.ends);
+            }
+        }
+
+        auto begin = text.data();
+        auto end = begin + text.size();
+        for (auto scanner : available_scanners()) {
+            for (std::size_t i = 0; i < text.size(); i += 7) {
+                EXPECT_EQ(scanner->skip_whitespace(begin + i, end),
+                          scalar.skip_whitespace(begin + i, end));
+                EXPECT_EQ(scanner->find_whitespace(begin + i, end),
+                          scalar.find_whitespace(begin + i, end));
+            }
+        }
+    }
+}
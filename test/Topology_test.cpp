@@ -0,0 +1,435 @@
+#include <gmock/gmock.h>
+#include "TestConfig.h"
+#include "ExceptionTestMacros.h"
+#include "gmshparsercpp/Topology.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+using namespace gmshparsercpp;
+using namespace testing;
+
+namespace {
+
+MshFile::Node
+make_node_block(std::vector<int> tags)
+{
+    MshFile::Node node;
+    node.tags.assign(tags.begin(), tags.end());
+    node.coordinates.resize(tags.size());
+    return node;
+}
+
+MshFile::ElementBlock
+make_element_block(ElementType type, std::vector<int> element_tags, std::vector<int> connectivity)
+{
+    MshFile::ElementBlock blk;
+    blk.element_type = type;
+    blk.dimension = element_info(type).dimension;
+    blk.element_tags.assign(element_tags.begin(), element_tags.end());
+    blk.connectivity.assign(connectivity.begin(), connectivity.end());
+    return blk;
+}
+
+std::vector<std::size_t>
+row(const Csr & csr, std::size_t i)
+{
+    return { csr.begin(i), csr.end(i) };
+}
+
+/// Nodes of a 3x3x3 grid, tag of node (x, y, z) is `1 + x + 3 y + 9 z`
+std::pmr::vector<MshFile::Node>
+grid_nodes()
+{
+    std::vector<int> tags(27);
+    std::iota(tags.begin(), tags.end(), 1);
+    std::pmr::vector<MshFile::Node> nodes;
+    nodes.push_back(make_node_block(tags));
+    return nodes;
+}
+
+/// Connectivity of the unit HEX8 with origin at grid point (x, y, z)
+std::vector<int>
+hex(int x, int y, int z)
+{
+    auto t = [](int x, int y, int z) { return 1 + x + 3 * y + 9 * z; };
+    return { t(x, y, z),         t(x + 1, y, z),         t(x + 1, y + 1, z),
+             t(x, y + 1, z),     t(x, y, z + 1),         t(x + 1, y, z + 1),
+             t(x + 1, y + 1, z + 1), t(x, y + 1, z + 1) };
+}
+
+/// Sorted corner nodes of each face of an element
+std::vector<std::vector<int>>
+element_faces(const MshFile::ElementBlock & blk, std::size_t i)
+{
+    auto & topo = reference_topology(element_info(blk.element_type).family);
+    std::vector<std::vector<int>> faces;
+    for (int f = 0; f < topo.num_faces; f++) {
+        std::vector<int> face;
+        for (int j = 0; j < topo.faces[f].num_nodes; j++)
+            face.push_back(blk.get_node_tags(i)[topo.faces[f].nodes[j]]);
+        std::sort(face.begin(), face.end());
+        faces.push_back(face);
+    }
+    return faces;
+}
+
+} // namespace
+
+TEST(TopologyTest, node_numbering)
+{
+    std::pmr::vector<MshFile::Node> nodes;
+    nodes.push_back(make_node_block({ 10, 12 }));
+    nodes.push_back(make_node_block({ 11 }));
+    NodeNumbering numbering(nodes);
+    EXPECT_EQ(numbering.size(), 3);
+    EXPECT_EQ(numbering.index(10), 0);
+    EXPECT_EQ(numbering.index(12), 1);
+    EXPECT_EQ(numbering.index(11), 2);
+    EXPECT_EQ(numbering.tag(2), 11);
+    EXPECT_EQ(numbering.find(9), NodeNumbering::INVALID);
+    EXPECT_EQ(numbering.find(13), NodeNumbering::INVALID);
+    EXPECT_THROW_MSG(numbering.index(-1), "Unknown node tag '-1'.");
+
+    nodes.push_back(make_node_block({ 12 }));
+    EXPECT_THROW_MSG(NodeNumbering { nodes }, "Duplicate node tag '12'.");
+}
+
+TEST(TopologyTest, node_numbering_sparse)
+{
+    std::pmr::vector<MshFile::Node> nodes;
+    nodes.push_back(make_node_block({ std::numeric_limits<int>::max(), 1 }));
+    nodes.push_back(make_node_block({ -5 }));
+    NodeNumbering numbering(nodes);
+    EXPECT_FALSE(numbering.is_dense());
+    EXPECT_EQ(numbering.size(), 3);
+    EXPECT_EQ(numbering.index(std::numeric_limits<int>::max()), 0);
+    EXPECT_EQ(numbering.index(1), 1);
+    EXPECT_EQ(numbering.index(-5), 2);
+    EXPECT_EQ(numbering.tag(0), std::numeric_limits<int>::max());
+    EXPECT_EQ(numbering.find(2), NodeNumbering::INVALID);
+    EXPECT_EQ(numbering.find(-6), NodeNumbering::INVALID);
+    EXPECT_EQ(numbering.find(std::numeric_limits<int>::min()), NodeNumbering::INVALID);
+    EXPECT_THROW_MSG(numbering.index(0), "Unknown node tag '0'.");
+
+    std::pmr::vector<MshFile::Node> dense;
+    dense.push_back(make_node_block({ 1, 8 }));
+    EXPECT_TRUE(NodeNumbering(dense).is_dense());
+
+    nodes.push_back(make_node_block({ 1 }));
+    EXPECT_THROW_MSG(NodeNumbering { nodes }, "Duplicate node tag '1'.");
+}
+
+TEST(TopologyTest, element_numbering)
+{
+    std::pmr::vector<MshFile::ElementBlock> blocks;
+    blocks.push_back(make_element_block(LINE2, { 1, 2 }, { 1, 2, 2, 3 }));
+    blocks.push_back(make_element_block(TRI3, { 3 }, { 1, 2, 3 }));
+    blocks.push_back(make_element_block(LINE2, { 4, 5, 6 }, { 3, 4, 4, 5, 5, 6 }));
+
+    ElementNumbering all(blocks);
+    EXPECT_EQ(all.size(), 6);
+    EXPECT_EQ(all.num_blocks(), 3);
+    EXPECT_EQ(all.offset(2), 3);
+    EXPECT_EQ(all.find_block(0), 0);
+    EXPECT_EQ(all.find_block(2), 1);
+    EXPECT_EQ(all.find_block(5), 2);
+    EXPECT_THROW_MSG(all.find_block(6), "Element '6' is out of range.");
+
+    ElementNumbering sel(blocks, { 2, 0 });
+    EXPECT_EQ(sel.size(), 5);
+    EXPECT_EQ(sel.block_index(0), 2);
+    EXPECT_EQ(&sel.block(1), &blocks[0]);
+    EXPECT_EQ(sel.find_block(3), 1);
+
+    EXPECT_THROW_MSG(ElementNumbering(blocks, { 3 }), "Element block index '3' is out of range.");
+}
+
+TEST(TopologyTest, node_to_element)
+{
+    // two quads and a triangle sharing nodes 2 and 5
+    //  4---5---6
+    //  |   |\  |
+    //  1---2---3
+    std::pmr::vector<MshFile::Node> nodes;
+    nodes.push_back(make_node_block({ 1, 2, 3, 4, 5, 6 }));
+    std::pmr::vector<MshFile::ElementBlock> blocks;
+    blocks.push_back(make_element_block(QUAD4, { 1 }, { 1, 2, 5, 4 }));
+    blocks.push_back(make_element_block(TRI3, { 2, 3 }, { 2, 3, 5, 3, 6, 5 }));
+
+    for (unsigned int n_threads : { 1, 3 }) {
+        auto csr = build_node_to_element(NodeNumbering(nodes), ElementNumbering(blocks), n_threads);
+        ASSERT_EQ(csr.size(), 6);
+        EXPECT_THAT(row(csr, 0), ElementsAre(0));
+        EXPECT_THAT(row(csr, 1), ElementsAre(0, 1));
+        EXPECT_THAT(row(csr, 2), ElementsAre(1, 2));
+        EXPECT_THAT(row(csr, 3), ElementsAre(0));
+        EXPECT_THAT(row(csr, 4), ElementsAre(0, 1, 2));
+        EXPECT_THAT(row(csr, 5), ElementsAre(2));
+        EXPECT_EQ(csr.degree(4), 3);
+    }
+
+    // only the triangles
+    auto csr = build_node_to_element(NodeNumbering(nodes), ElementNumbering(blocks, { 1 }));
+    EXPECT_THAT(csr.offsets, ElementsAre(0, 0, 1, 3, 3, 5, 6));
+    EXPECT_THAT(csr.indices, ElementsAre(0, 0, 1, 0, 1, 1));
+
+    blocks.push_back(make_element_block(LINE2, { 4 }, { 6, 7 }));
+    EXPECT_THROW_MSG(build_node_to_element(NodeNumbering(nodes), ElementNumbering(blocks)),
+                     "Unknown node tag '7'.");
+}
+
+TEST(TopologyTest, node_to_element_file)
+{
+    MshFile f(std::string(GMSHPARSERCPP_ASSETS_DIR) + "/prism-v4.asc.msh");
+    f.parse();
+    NodeNumbering nodes(f.get_nodes());
+    ElementNumbering elements(f.get_element_blocks());
+    auto csr = build_node_to_element(nodes, elements, 4);
+
+    // serial reference
+    std::vector<std::vector<std::size_t>> gold(nodes.size());
+    for (std::size_t k = 0; k < elements.num_blocks(); k++) {
+        auto & blk = elements.block(k);
+        for (std::size_t i = 0; i < blk.size(); i++)
+            for (int j = 0; j < blk.get_num_nodes_per_element(); j++)
+                gold[nodes.index(blk.get_node_tags(i)[j])].push_back(elements.offset(k) + i);
+    }
+    ASSERT_EQ(csr.size(), nodes.size());
+    for (std::size_t i = 0; i < nodes.size(); i++)
+        EXPECT_EQ(row(csr, i), gold[i]);
+}
+
+TEST(TopologyTest, node_graph)
+{
+    std::pmr::vector<MshFile::Node> nodes;
+    nodes.push_back(make_node_block({ 1, 2, 3, 4, 5, 6 }));
+    std::pmr::vector<MshFile::ElementBlock> blocks;
+    blocks.push_back(make_element_block(QUAD4, { 1 }, { 1, 2, 5, 4 }));
+    blocks.push_back(make_element_block(TRI3, { 2, 3 }, { 2, 3, 5, 3, 6, 5 }));
+    NodeNumbering nn(nodes);
+    ElementNumbering en(blocks);
+
+    auto g = build_node_graph(nn, en, 2);
+    ASSERT_EQ(g.size(), 6);
+    EXPECT_THAT(row(g, 0), ElementsAre(1, 3, 4));
+    EXPECT_THAT(row(g, 1), ElementsAre(0, 2, 3, 4));
+    EXPECT_THAT(row(g, 2), ElementsAre(1, 4, 5));
+    EXPECT_THAT(row(g, 3), ElementsAre(0, 1, 4));
+    EXPECT_THAT(row(g, 4), ElementsAre(0, 1, 2, 3, 5));
+    EXPECT_THAT(row(g, 5), ElementsAre(2, 4));
+}
+
+TEST(TopologyTest, dual_graph_2d)
+{
+    // same mesh as in `node_to_element`: the quad and the second triangle share only node 5
+    std::pmr::vector<MshFile::Node> nodes;
+    nodes.push_back(make_node_block({ 1, 2, 3, 4, 5, 6 }));
+    std::pmr::vector<MshFile::ElementBlock> blocks;
+    blocks.push_back(make_element_block(QUAD4, { 1 }, { 1, 2, 5, 4 }));
+    blocks.push_back(make_element_block(TRI3, { 2, 3 }, { 2, 3, 5, 3, 6, 5 }));
+    NodeNumbering nn(nodes);
+    ElementNumbering en(blocks);
+
+    for (auto conn : { DualGraphConnection::FACE, DualGraphConnection::EDGE }) {
+        auto g = build_dual_graph(nn, en, conn, 2);
+        ASSERT_EQ(g.size(), 3);
+        EXPECT_THAT(g.offsets, ElementsAre(0, 1, 3, 4));
+        EXPECT_THAT(g.indices, ElementsAre(1, 0, 2, 1));
+    }
+    auto g = build_dual_graph(nn, en, DualGraphConnection::VERTEX, 2);
+    EXPECT_THAT(g.offsets, ElementsAre(0, 2, 4, 6));
+    EXPECT_THAT(g.indices, ElementsAre(1, 2, 0, 2, 0, 1));
+}
+
+TEST(TopologyTest, dual_graph_3d)
+{
+    // A and B share a face, A and C an edge, B and C a face, D shares a face with A, an edge with B
+    // and a vertex with C
+    auto nodes = grid_nodes();
+    std::pmr::vector<MshFile::ElementBlock> blocks;
+    std::vector<int> conn;
+    for (auto h : { hex(0, 0, 0), hex(1, 0, 0), hex(1, 1, 0), hex(0, 0, 1) })
+        conn.insert(conn.end(), h.begin(), h.end());
+    blocks.push_back(make_element_block(HEX8, { 1, 2, 3, 4 }, conn));
+    NodeNumbering nn(nodes);
+    ElementNumbering en(blocks);
+
+    for (unsigned int n_threads : { 1, 4 }) {
+        auto g = build_dual_graph(nn, en, DualGraphConnection::FACE, n_threads);
+        ASSERT_EQ(g.size(), 4);
+        EXPECT_THAT(row(g, 0), ElementsAre(1, 3));
+        EXPECT_THAT(row(g, 1), ElementsAre(0, 2));
+        EXPECT_THAT(row(g, 2), ElementsAre(1));
+        EXPECT_THAT(row(g, 3), ElementsAre(0));
+
+        g = build_dual_graph(nn, en, DualGraphConnection::EDGE, n_threads);
+        EXPECT_THAT(row(g, 0), ElementsAre(1, 2, 3));
+        EXPECT_THAT(row(g, 1), ElementsAre(0, 2, 3));
+        EXPECT_THAT(row(g, 2), ElementsAre(0, 1));
+        EXPECT_THAT(row(g, 3), ElementsAre(0, 1));
+
+        g = build_dual_graph(nn, en, DualGraphConnection::VERTEX, n_threads);
+        EXPECT_THAT(row(g, 0), ElementsAre(1, 2, 3));
+        EXPECT_THAT(row(g, 2), ElementsAre(0, 1, 3));
+        EXPECT_THAT(row(g, 3), ElementsAre(0, 1, 2));
+    }
+}
+
+TEST(TopologyTest, dual_graph_file)
+{
+    MshFile f(std::string(GMSHPARSERCPP_ASSETS_DIR) + "/prism-v4.asc.msh");
+    f.parse();
+    auto & blocks = f.get_element_blocks();
+    std::vector<std::size_t> vol;
+    for (std::size_t k = 0; k < blocks.size(); k++)
+        if (blocks[k].dimension == 3)
+            vol.push_back(k);
+    ASSERT_FALSE(vol.empty());
+    NodeNumbering nn(f.get_nodes());
+    ElementNumbering en(blocks, vol);
+    auto g = build_dual_graph(nn, en, DualGraphConnection::FACE, 3);
+
+    // brute force: elements sharing a face
+    std::vector<std::vector<std::vector<int>>> faces;
+    for (std::size_t k = 0; k < en.num_blocks(); k++)
+        for (std::size_t i = 0; i < en.block(k).size(); i++)
+            faces.push_back(element_faces(en.block(k), i));
+    ASSERT_EQ(g.size(), faces.size());
+    std::size_t n_edges = 0;
+    for (std::size_t a = 0; a < faces.size(); a++) {
+        std::vector<std::size_t> gold;
+        for (std::size_t b = 0; b < faces.size(); b++) {
+            if (a == b)
+                continue;
+            for (auto & fa : faces[a])
+                if (std::find(faces[b].begin(), faces[b].end(), fa) != faces[b].end()) {
+                    gold.push_back(b);
+                    break;
+                }
+        }
+        EXPECT_EQ(row(g, a), gold);
+        n_edges += gold.size();
+    }
+    EXPECT_GT(n_edges, 0);
+}
+
+TEST(TopologyTest, boundary_2d)
+{
+    std::pmr::vector<MshFile::Node> nodes;
+    nodes.push_back(make_node_block({ 1, 2, 3, 4, 5, 6 }));
+    std::pmr::vector<MshFile::ElementBlock> blocks;
+    blocks.push_back(make_element_block(QUAD4, { 1 }, { 1, 2, 5, 4 }));
+    blocks.push_back(make_element_block(TRI3, { 2, 3 }, { 2, 3, 5, 3, 6, 5 }));
+    NodeNumbering nn(nodes);
+    ElementNumbering en(blocks);
+
+    auto bnd = extract_boundary(nn, en, 2);
+    ASSERT_EQ(bnd.size(), 2);
+    EXPECT_EQ(bnd[0].block.element_type, LINE2);
+    EXPECT_EQ(bnd[0].block.dimension, 1);
+    EXPECT_EQ(bnd[0].parent_block, 0);
+    EXPECT_THAT(bnd[0].block.element_tags, ElementsAre(1, 2, 3));
+    EXPECT_THAT(bnd[0].block.connectivity, ElementsAre(1, 2, 5, 4, 4, 1));
+    EXPECT_THAT(bnd[0].parents, ElementsAre(0, 0, 0));
+    EXPECT_THAT(bnd[0].local_sides, ElementsAre(0, 2, 3));
+
+    EXPECT_EQ(bnd[1].block.element_type, LINE2);
+    EXPECT_EQ(bnd[1].parent_block, 1);
+    EXPECT_THAT(bnd[1].block.element_tags, ElementsAre(4, 5, 6));
+    EXPECT_THAT(bnd[1].block.connectivity, ElementsAre(2, 3, 3, 6, 6, 5));
+    EXPECT_THAT(bnd[1].parents, ElementsAre(1, 2, 2));
+    EXPECT_THAT(bnd[1].local_sides, ElementsAre(0, 0, 1));
+}
+
+TEST(TopologyTest, boundary_3d)
+{
+    // 2x2x2 hexes filling the grid
+    auto nodes = grid_nodes();
+    std::pmr::vector<MshFile::ElementBlock> blocks;
+    std::vector<int> conn;
+    for (int z = 0; z < 2; z++)
+        for (int y = 0; y < 2; y++)
+            for (int x = 0; x < 2; x++) {
+                auto h = hex(x, y, z);
+                conn.insert(conn.end(), h.begin(), h.end());
+            }
+    blocks.push_back(make_element_block(HEX8, { 1, 2, 3, 4, 5, 6, 7, 8 }, conn));
+    NodeNumbering nn(nodes);
+    ElementNumbering en(blocks);
+
+    auto coord = [](int tag, int d) {
+        int i = tag - 1;
+        return d == 0 ? i % 3 : (d == 1 ? i / 3 % 3 : i / 9);
+    };
+    for (unsigned int n_threads : { 1, 4 }) {
+        auto bnd = extract_boundary(nn, en, n_threads);
+        ASSERT_EQ(bnd.size(), 1);
+        auto & blk = bnd[0].block;
+        EXPECT_EQ(blk.element_type, QUAD4);
+        EXPECT_EQ(blk.dimension, 2);
+        ASSERT_EQ(blk.size(), 24);
+        for (std::size_t i = 0; i < blk.size(); i++) {
+            auto face = blk.get_node_tags(i);
+            // the face lies on the side of the cube and its normal points out of it
+            double a[3] = {}, b[3] = {}, n[3], c[3] = {};
+            for (int d = 0; d < 3; d++) {
+                a[d] = coord(face[1], d) - coord(face[0], d);
+                b[d] = coord(face[3], d) - coord(face[0], d);
+                c[d] = 0.25 * (coord(face[0], d) + coord(face[1], d) + coord(face[2], d) +
+                               coord(face[3], d)) -
+                       1.;
+            }
+            n[0] = a[1] * b[2] - a[2] * b[1];
+            n[1] = a[2] * b[0] - a[0] * b[2];
+            n[2] = a[0] * b[1] - a[1] * b[0];
+            EXPECT_GT(n[0] * c[0] + n[1] * c[1] + n[2] * c[2], 0.);
+            EXPECT_DOUBLE_EQ(std::max({ std::abs(c[0]), std::abs(c[1]), std::abs(c[2]) }), 1.);
+
+            auto parent = blocks[0].get_node_tags(bnd[0].parents[i]);
+            auto & topo = reference_topology(element_info(HEX8).family);
+            auto & rf = topo.faces[bnd[0].local_sides[i]];
+            for (int j = 0; j < 4; j++)
+                EXPECT_EQ(face[j], parent[rf.nodes[j]]);
+        }
+    }
+}
+
+TEST(TopologyTest, boundary_file)
+{
+    MshFile f(std::string(GMSHPARSERCPP_ASSETS_DIR) + "/prism-v4.asc.msh");
+    f.parse();
+    auto & blocks = f.get_element_blocks();
+    std::vector<std::size_t> vol;
+    for (std::size_t k = 0; k < blocks.size(); k++)
+        if (blocks[k].dimension == 3)
+            vol.push_back(k);
+    NodeNumbering nn(f.get_nodes());
+    ElementNumbering en(blocks, vol);
+    auto bnd = extract_boundary(nn, en, 3);
+
+    // brute force: faces of exactly one element
+    std::vector<std::vector<int>> all;
+    for (std::size_t k = 0; k < en.num_blocks(); k++)
+        for (std::size_t i = 0; i < en.block(k).size(); i++)
+            for (auto & fc : element_faces(en.block(k), i))
+                all.push_back(fc);
+    std::vector<std::vector<int>> gold;
+    for (auto & fc : all)
+        if (std::count(all.begin(), all.end(), fc) == 1)
+            gold.push_back(fc);
+    std::sort(gold.begin(), gold.end());
+
+    std::vector<std::vector<int>> found;
+    for (auto & bs : bnd)
+        for (std::size_t i = 0; i < bs.block.size(); i++) {
+            auto tags = bs.block.get_node_tags(i);
+            std::vector<int> fc(tags, tags + element_info(bs.block.element_type).num_nodes);
+            std::sort(fc.begin(), fc.end());
+            found.push_back(fc);
+        }
+    std::sort(found.begin(), found.end());
+    EXPECT_FALSE(gold.empty());
+    EXPECT_EQ(found, gold);
+}